@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    AdaptiveSampler.cpp
+    Created: 18 Oct 2026 8:32:25pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "AdaptiveSampler.h"
+
+//==============================================================================
+AdaptiveSampler::AdaptiveSampler()
+{
+    for (int k = 0; k < Global::numCoeffs / 2; ++k)
+    {
+        b[k] = 0;
+        a[k] = 0;
+    }
+    result = std::make_shared<Result>();
+}
+
+void AdaptiveSampler::setLogGrid (bool logPlotToSet, double logBaseToSet)
+{
+    logPlot = logPlotToSet;
+    logBase = logBaseToSet;
+}
+
+void AdaptiveSampler::setRoots (const std::vector<std::complex<double>>& zerosToSet, const std::vector<std::complex<double>>& polesToSet)
+{
+    zeros = zerosToSet;
+    poles = polesToSet;
+
+    // A pole close to the unit circle gives a peak at its angle with a width of about 1 - |p|,
+    // so the peak and both of its half-power points are added to the starting grid.
+    hintOmegas.clear();
+    for (auto& pole : poles)
+    {
+        double radius = std::abs (pole);
+        if (radius < Global::adaptiveHintRadius)
+            continue;
+
+        double angle = std::abs (std::arg (pole));
+        hintOmegas.push_back (angle);
+        if (radius < 1.0)
+        {
+            hintOmegas.push_back (angle - (1.0 - radius));
+            hintOmegas.push_back (angle + (1.0 - radius));
+        }
+    }
+}
+
+void AdaptiveSampler::calculate (const std::vector<double>& coefficients)
+{
+    AnalysisCache::Key key ("adaptive response", coefficients, { logPlot ? 1.0 : 0.0, logBase });
+    if (auto cachedResult = cache->get<Result> (key))
+    {
+        result = cachedResult;
+        return;
+    }
+
+    int halfNumCoeffs = Global::numCoeffs / 2;
+    sumAbsNumerator = 0;
+    sumAbsDenominator = 0;
+    for (int k = 0; k < halfNumCoeffs; ++k)
+    {
+        b[k] = coefficients[k];
+        a[k] = k == 0 ? 1.0 : -coefficients[k + halfNumCoeffs];
+        sumAbsNumerator += std::abs (b[k]);
+        sumAbsDenominator += std::abs (a[k]);
+    }
+    productForm = ResponseEngine::makeProductForm (coefficients, zeros, poles);
+    numProductFormPoints = 0;
+
+    samples.clear();
+    intervals.clear();
+
+    // starting grid: uniform on the plot axis plus the hints
+    std::vector<double> startPositions;
+    for (int i = 0; i <= Global::adaptiveCoarsePoints; ++i)
+        startPositions.push_back (i / static_cast<double> (Global::adaptiveCoarsePoints));
+    for (auto omega : hintOmegas)
+        if (omega > 0 && omega < double_Pi)
+            startPositions.push_back (ResponseEngine::omegaToPosition (omega, logPlot, logBase));
+    std::sort (startPositions.begin(), startPositions.end());
+
+    std::vector<int> startIdx;
+    for (auto position : startPositions)
+        if (startIdx.empty() || position - samples[startIdx.back()].position > Global::adaptiveMinWidth)
+            startIdx.push_back (addSample (position));
+
+    for (int i = 1; i < startIdx.size(); ++i)
+        addInterval (startIdx[i - 1], startIdx[i]);
+
+    // keep splitting the worst interval; every split costs two evaluations
+    while (!intervals.empty() && samples.size() + 2 <= Global::adaptiveMaxPoints)
+    {
+        std::pop_heap (intervals.begin(), intervals.end());
+        Interval worst = intervals.back();
+        if (worst.error < Global::adaptiveToleranceDB)
+            break;
+        intervals.pop_back();
+
+        addInterval (worst.left, worst.middle);
+        addInterval (worst.middle, worst.right);
+    }
+
+    std::sort (samples.begin(), samples.end(), [] (const Sample& lhs, const Sample& rhs) { return lhs.position < rhs.position; });
+
+    auto newResult = std::make_shared<Result>();
+    newResult->positions.resize (samples.size());
+    newResult->response.resize (samples.size());
+    newResult->dB.resize (samples.size());
+    for (int i = 0; i < samples.size(); ++i)
+    {
+        newResult->positions[i] = samples[i].position;
+        newResult->response[i] = samples[i].response;
+        newResult->dB[i] = samples[i].dB;
+    }
+    newResult->numEvaluations = static_cast<int> (samples.size());
+    newResult->numProductFormPoints = numProductFormPoints;
+
+    result = newResult;
+    cache->put<Result> (key, result, sizeof (Result) + AnalysisCache::getVectorBytes (result->positions)
+                                     + AnalysisCache::getVectorBytes (result->response) + AnalysisCache::getVectorBytes (result->dB));
+}
+
+int AdaptiveSampler::addSample (double position)
+{
+    // B(z^-1) / A(z^-1) at z^-1 = e^-jw with Horner's method
+    double omega = ResponseEngine::positionToOmega (position, logPlot, logBase);
+    std::complex<double> zInv (cos (omega), -sin (omega));
+    std::complex<double> numerator (b[Global::numCoeffs / 2 - 1], 0.0);
+    std::complex<double> denominator (a[Global::numCoeffs / 2 - 1], 0.0);
+    for (int k = Global::numCoeffs / 2 - 2; k >= 0; --k)
+    {
+        numerator = numerator * zInv + b[k];
+        denominator = denominator * zInv + a[k];
+    }
+
+    Sample sample;
+    sample.position = position;
+    if (productForm.valid
+        && (ResponseEngine::isIllConditioned (sumAbsNumerator, std::abs (numerator))
+            || ResponseEngine::isIllConditioned (sumAbsDenominator, std::abs (denominator))))
+    {
+        double groupDelay;
+        sample.response = ResponseEngine::evaluateProductForm (productForm, omega, groupDelay);
+        ++numProductFormPoints;
+    }
+    else
+    {
+        sample.response = numerator / denominator;
+    }
+    sample.dB = std::isfinite (std::abs (sample.response)) ? jmax (20.0 * log10 (std::abs (sample.response)), Global::adaptiveFloorDB) : -Global::adaptiveFloorDB;
+    samples.push_back (sample);
+    return static_cast<int> (samples.size()) - 1;
+}
+
+void AdaptiveSampler::addInterval (int left, int right)
+{
+    if (samples[right].position - samples[left].position < 2.0 * Global::adaptiveMinWidth)
+        return;
+
+    Interval interval;
+    interval.left = left;
+    interval.right = right;
+    interval.middle = addSample (0.5 * (samples[left].position + samples[right].position));
+
+    // how far the middle is off a straight line (curvature), and how fast the magnitude changes over the interval
+    double leftDB = samples[left].dB;
+    double rightDB = samples[right].dB;
+    double curvatureError = std::abs (samples[interval.middle].dB - 0.5 * (leftDB + rightDB));
+    double slopeError = std::abs (rightDB - leftDB) * Global::adaptiveToleranceDB / Global::adaptiveMaxStepDB;
+    interval.error = std::max (curvatureError, slopeError);
+
+    intervals.push_back (interval);
+    std::push_heap (intervals.begin(), intervals.end());
+}
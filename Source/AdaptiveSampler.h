@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    AdaptiveSampler.h
+    Created: 18 Oct 2026 8:32:25pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include "ResponseEngine.h"
+#include "AnalysisCache.h"
+#include <complex>
+
+//==============================================================================
+/*
+    Samples the magnitude response on a non-uniform grid. It starts from a coarse
+    grid plus the angles of the poles, and keeps splitting the interval where
+    straight lines between the samples are the furthest off in dB, until every
+    interval is within the tolerance or the budget is used up.
+
+    The grid is given as positions between 0 and 1 along the frequency axis of
+    the plot (so it follows the linear or logarithmic axis). Results are kept in
+    the shared analysis cache.
+*/
+class AdaptiveSampler
+{
+public:
+    AdaptiveSampler();
+
+    void setLogGrid (bool logPlot, double logBase = 1000);
+
+    // The angles of the poles are added to the starting grid so narrow peaks are not missed. The roots are also
+    // used to evaluate the points where the expanded polynomials are ill-conditioned.
+    void setRoots (const std::vector<std::complex<double>>& zerosToSet, const std::vector<std::complex<double>>& polesToSet);
+
+    void calculate (const std::vector<double>& coefficients);
+
+    const std::vector<double>& getPositions() { return result->positions; };
+    const std::vector<std::complex<double>>& getResponse() { return result->response; };
+    const std::vector<double>& getDB() { return result->dB; };
+    int getNumEvaluations() { return result->numEvaluations; };
+    int getNumProductFormPoints() { return result->numProductFormPoints; };
+
+private:
+    struct Sample
+    {
+        double position;
+        std::complex<double> response;
+        double dB;
+    };
+
+    // an interval between two samples with the sample in its middle
+    struct Interval
+    {
+        int left, middle, right;
+        double error;
+        bool operator< (const Interval& other) const { return error < other.error; };
+    };
+
+    struct Result
+    {
+        std::vector<double> positions;
+        std::vector<std::complex<double>> response;
+        std::vector<double> dB;
+        int numEvaluations = 0;
+        int numProductFormPoints = 0;
+    };
+
+    int addSample (double position);
+    void addInterval (int left, int right);
+
+    bool logPlot = false;
+    double logBase = 1000;
+
+    double b[Global::numCoeffs / 2];
+    double a[Global::numCoeffs / 2];
+
+    std::vector<double> hintOmegas;
+    
+    std::vector<std::complex<double>> zeros;
+    std::vector<std::complex<double>> poles;
+    ResponseEngine::ProductForm productForm;
+    double sumAbsNumerator = 0;
+    double sumAbsDenominator = 0;
+    int numProductFormPoints = 0;
+
+    std::vector<Sample> samples;
+    std::vector<Interval> intervals; // kept as a heap with the largest error on top
+
+    std::shared_ptr<const Result> result;
+    SharedResourcePointer<AnalysisCache> cache;
+};
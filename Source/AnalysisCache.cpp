@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    AnalysisCache.cpp
+    Created: 18 Oct 2026 8:40:35pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "AnalysisCache.h"
+
+//==============================================================================
+AnalysisCache::Key::Key (const String& kind, const std::vector<double>& coefficients, std::initializer_list<double> parameters) : kind (kind)
+{
+    values.reserve (coefficients.size() + parameters.size());
+    values.insert (values.end(), coefficients.begin(), coefficients.end());
+    values.insert (values.end(), parameters.begin(), parameters.end());
+
+    // FNV-1a over the bytes of the values, starting from the hash of the kind
+    uint64 fnv = 14695981039346656037ull ^ static_cast<uint64> (kind.hashCode64());
+    for (auto& value : values)
+    {
+        // -0 and 0 are the same value, and so are all NaNs, so they need to give the same bits
+        if (value == 0)
+            value = 0;
+        else if (std::isnan (value))
+            value = std::numeric_limits<double>::quiet_NaN();
+
+        uint64 bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+        for (int i = 0; i < 8; ++i)
+        {
+            fnv ^= (bits >> (8 * i)) & 0xff;
+            fnv *= 1099511628211ull;
+        }
+    }
+    hash = static_cast<size_t> (fnv);
+}
+
+bool AnalysisCache::Key::operator== (const Key& other) const
+{
+    return hash == other.hash && kind == other.kind && values.size() == other.values.size()
+        && std::memcmp (values.data(), other.values.data(), values.size() * sizeof (double)) == 0;
+}
+
+AnalysisCache::AnalysisCache()
+{
+}
+
+AnalysisCache::~AnalysisCache()
+{
+    Logger::writeToLog (getReport());
+}
+
+std::shared_ptr<const void> AnalysisCache::find (const Key& key)
+{
+    const ScopedLock sl (lock);
+
+    auto it = lookup.find (key);
+    if (it == lookup.end())
+    {
+        ++misses;
+        return nullptr;
+    }
+
+    // move the entry to the front of the list
+    entries.splice (entries.begin(), entries, it->second);
+    ++hits;
+    return it->second->result;
+}
+
+void AnalysisCache::insert (const Key& key, std::shared_ptr<const void> result, size_t bytes)
+{
+    const ScopedLock sl (lock);
+
+    // results that do not fit at all are not kept
+    if (result == nullptr || bytes > static_cast<size_t> (Global::analysisCacheSize))
+        return;
+
+    auto it = lookup.find (key);
+    if (it != lookup.end())
+    {
+        memoryUsage -= it->second->bytes;
+        entries.erase (it->second);
+        lookup.erase (it);
+    }
+
+    entries.push_front ({ key, result, bytes });
+    lookup[key] = entries.begin();
+    memoryUsage += bytes;
+
+    evict();
+}
+
+void AnalysisCache::evict()
+{
+    bool wasFull = evictions > 0;
+    while (memoryUsage > static_cast<size_t> (Global::analysisCacheSize))
+    {
+        // keys compare bit for bit, so the map entry of the last entry is always found
+        auto it = lookup.find (entries.back().key);
+        jassert (it != lookup.end() && it->second == std::prev (entries.end()));
+        if (it != lookup.end())
+            lookup.erase (it);
+
+        memoryUsage -= entries.back().bytes;
+        entries.pop_back();
+        ++evictions;
+    }
+
+    if (!wasFull && evictions > 0)
+        Logger::writeToLog (getReport());
+}
+
+void AnalysisCache::clear()
+{
+    const ScopedLock sl (lock);
+    lookup.clear();
+    entries.clear();
+    memoryUsage = 0;
+}
+
+size_t AnalysisCache::getMemoryUsage()
+{
+    const ScopedLock sl (lock);
+    return memoryUsage;
+}
+
+int AnalysisCache::getNumEntries()
+{
+    const ScopedLock sl (lock);
+    return static_cast<int> (entries.size());
+}
+
+String AnalysisCache::getReport()
+{
+    const ScopedLock sl (lock);
+    return "Analysis cache: " + String (static_cast<int> (entries.size())) + " entries, "
+        + String (memoryUsage / 1048576.0, 2) + " of " + String (Global::analysisCacheSize / 1048576.0, 2) + " MB, "
+        + String (hits) + " hits, " + String (misses) + " misses, " + String (evictions) + " evicted";
+}
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    AnalysisCache.h
+    Created: 18 Oct 2026 8:40:35pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include <list>
+#include <unordered_map>
+#include <memory>
+
+using namespace juce;
+//==============================================================================
+/*
+    Results of the analyses (responses, roots, equation layouts) of the
+    coefficients that were shown last, so that going back to coefficients that
+    were shown before (undo, switching views, dragging back and forth) does not
+    calculate them again.
+
+    Entries are found with a hash map and kept in a list in order of use, so a
+    lookup is O(1). When the entries take up more than Global::analysisCacheSize
+    bytes, the entries that were used longest ago are removed.
+
+    Use it through a SharedResourcePointer<AnalysisCache> so every component
+    shares the same instance. The results are immutable once they are in the
+    cache, so they can be held on to while the cache drops them.
+*/
+class AnalysisCache
+{
+public:
+    // The kind of result (one type of result per kind), the coefficients and the parameters the result depends on.
+    // The hash is calculated once, on construction. Values are compared bit for bit, so a key with NaN values
+    // still equals itself.
+    struct Key
+    {
+        Key (const String& kind, const std::vector<double>& coefficients, std::initializer_list<double> parameters = {});
+        bool operator== (const Key& other) const;
+
+        String kind;
+        std::vector<double> values;
+        size_t hash;
+    };
+
+    AnalysisCache();
+    ~AnalysisCache();
+
+    template <typename T>
+    std::shared_ptr<const T> get (const Key& key)
+    {
+        return std::static_pointer_cast<const T> (find (key));
+    }
+
+    // bytes is the memory the result takes up, see getVectorBytes()
+    template <typename T>
+    void put (const Key& key, std::shared_ptr<const T> result, size_t bytes)
+    {
+        insert (key, std::static_pointer_cast<const void> (result), bytes);
+    }
+
+    template <typename T>
+    static size_t getVectorBytes (const std::vector<T>& vector) { return vector.capacity() * sizeof (T); };
+
+    void clear();
+
+    size_t getMemoryUsage();
+    int getNumEntries();
+    String getReport();
+
+private:
+    struct KeyHash
+    {
+        size_t operator() (const Key& key) const { return key.hash; };
+    };
+
+    struct Entry
+    {
+        Key key;
+        std::shared_ptr<const void> result;
+        size_t bytes;
+    };
+
+    std::shared_ptr<const void> find (const Key& key);
+    void insert (const Key& key, std::shared_ptr<const void> result, size_t bytes);
+    void evict();
+
+    CriticalSection lock;
+
+    std::list<Entry> entries; // most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+
+    size_t memoryUsage = 0;
+    int64 hits = 0;
+    int64 misses = 0;
+    int64 evictions = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisCache)
+};
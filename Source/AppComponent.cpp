@@ -17,7 +17,6 @@ AppComponent::AppComponent (String title, bool isEquation, bool isBlockDiagram)
     // In your constructor, you should add any child components, and
     // initialise any special settings that your component needs.
     equationFont.setHeight (25.0f);
-    coefficients.resize (Global::numCoeffs);
     if (!isEquation)
         data.resize (Global::fftOrder);
     
@@ -59,13 +58,15 @@ void AppComponent::resized()
     
 }
 
-void AppComponent::setCoefficients (std::vector<double>& coefficientsToSet)
+void AppComponent::setCoefficients (const FilterModel::Snapshot& snapshot, uint32 changeMaskToSet)
 {
-    coefficients = coefficientsToSet;
+    coefficients = snapshot;
+    changeMask |= changeMaskToSet;
 }
 
 void AppComponent::refresh()
 {
     calculate();
+    changeMask = 0;
     this->repaint();
 }
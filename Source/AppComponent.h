@@ -12,6 +12,8 @@
 
 #include <JuceHeader.h>
 #include "Global.h"
+#include "AnalysisCache.h"
+#include "FilterModel.h"
 #include <complex>
 
 using namespace juce;
@@ -30,12 +32,24 @@ public:
     void resized() override;
 
     String& getTitle() { return title; };
-    void setCoefficients (std::vector<double>& coefficientsToSet);
+    // a new snapshot of the filter model, changeMask says which coefficients differ from the previous one
+    virtual void setCoefficients (const FilterModel::Snapshot& snapshot, uint32 changeMaskToSet);
     
+    // whether the component has to be refreshed after a change of the coefficients in changeMask
+    virtual bool needsRefresh (uint32 changeMask) { return true; };
+    
+    // calculate() and repaint; changeMask is cleared afterwards, so a refresh without new coefficients sees 0
     void refresh();
     
     virtual void calculate() {};
     
+    // the roots found by the pole-zero plot, for components that evaluate the response from them
+    virtual void setRoots (const std::vector<std::complex<double>>& zeros, const std::vector<std::complex<double>>& poles) {};
+    
+    // The sample rate of the audio device. The responses are calculated on a normalised frequency axis,
+    // so this only changes the axes and the labels, and nothing has to be calculated again.
+    virtual void setSampleRate (double sampleRate) {};
+    
     void setScale (float scaleToSet) { scale = scaleToSet; };
     
 protected:
@@ -44,9 +58,13 @@ protected:
     
     float scale = 1.0f;
 
-    std::vector<double> coefficients;
+    FilterModel::Snapshot coefficients;
+    uint32 changeMask = FilterModel::allCoefficientsMask; // coefficients that changed since the last calculate()
     std::vector<std::complex<double>> data;
     
+    // results of calculate() shared between all components
+    SharedResourcePointer<AnalysisCache> analysisCache;
+    
 private:
     String title;
     bool isEquation;
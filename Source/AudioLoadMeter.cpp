@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    AudioLoadMeter.cpp
+    Created: 18 Oct 2026 8:56:15pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "AudioLoadMeter.h"
+
+//==============================================================================
+AudioLoadMeter::AudioLoadMeter()
+{
+    prepare (fs.load());
+}
+
+AudioLoadMeter::~AudioLoadMeter()
+{
+    if (numCallbacks > 0)
+        Logger::writeToLog ("Audio load: " + toJSON());
+}
+
+void AudioLoadMeter::prepare (double sampleRate)
+{
+    fs = sampleRate;
+    previousStartTicks = 0;
+    previousPeriod = 0;
+
+    numCallbacks = 0;
+    lastTime = 0;
+    worstTime = 0;
+    lastLoad = 0;
+    averageLoad = 0;
+    worstLoad = 0;
+    numOverruns = 0;
+    numGaps = 0;
+    for (auto& count : histogram)
+        count = 0;
+}
+
+void AudioLoadMeter::addCallback (int64 startTicks, int64 endTicks, int numSamples)
+{
+    // only the audio thread writes, so the values can be read, changed and stored without compare-and-swap loops
+    double time = Time::highResolutionTicksToSeconds (endTicks - startTicks);
+    double period = numSamples / fs.load();
+    double load = period > 0 ? time / period : 0.0;
+
+    lastTime.store (time, std::memory_order_relaxed);
+    lastLoad.store (load, std::memory_order_relaxed);
+    if (time > worstTime.load (std::memory_order_relaxed))
+        worstTime.store (time, std::memory_order_relaxed);
+    if (load > worstLoad.load (std::memory_order_relaxed))
+        worstLoad.store (load, std::memory_order_relaxed);
+
+    // exponential average over about Global::loadMeterAverageTime seconds
+    double alpha = jmin (1.0, period / Global::loadMeterAverageTime);
+    double average = numCallbacks.load (std::memory_order_relaxed) == 0 ? load : averageLoad.load (std::memory_order_relaxed);
+    averageLoad.store (average + alpha * (load - average), std::memory_order_relaxed);
+
+    if (load > 1.0)
+        numOverruns.fetch_add (1, std::memory_order_relaxed);
+    if (previousStartTicks != 0
+        && Time::highResolutionTicksToSeconds (startTicks - previousStartTicks) > Global::loadMeterGapFactor * previousPeriod)
+        numGaps.fetch_add (1, std::memory_order_relaxed);
+    previousStartTicks = startTicks;
+    previousPeriod = period;
+
+    int bin = jmin (numHistogramBins - 1, static_cast<int> (load * 10.0));
+    histogram[bin].fetch_add (1, std::memory_order_relaxed);
+
+    numCallbacks.fetch_add (1, std::memory_order_release);
+}
+
+AudioLoadMeter::Statistics AudioLoadMeter::getStatistics() const
+{
+    Statistics statistics;
+    statistics.numCallbacks = numCallbacks.load (std::memory_order_acquire);
+    statistics.lastTime = lastTime.load (std::memory_order_relaxed);
+    statistics.worstTime = worstTime.load (std::memory_order_relaxed);
+    statistics.lastLoad = lastLoad.load (std::memory_order_relaxed);
+    statistics.averageLoad = averageLoad.load (std::memory_order_relaxed);
+    statistics.worstLoad = worstLoad.load (std::memory_order_relaxed);
+    statistics.numOverruns = numOverruns.load (std::memory_order_relaxed);
+    statistics.numGaps = numGaps.load (std::memory_order_relaxed);
+    for (int i = 0; i < numHistogramBins; ++i)
+        statistics.histogram[i] = histogram[i].load (std::memory_order_relaxed);
+    return statistics;
+}
+
+String AudioLoadMeter::toJSON() const
+{
+    Statistics statistics = getStatistics();
+
+    Array<var> histogramValues;
+    for (auto count : statistics.histogram)
+        histogramValues.add (count);
+
+    DynamicObject::Ptr object = new DynamicObject();
+    object->setProperty ("sampleRate", fs.load());
+    object->setProperty ("numCallbacks", statistics.numCallbacks);
+    object->setProperty ("lastTimeMs", statistics.lastTime * 1000.0);
+    object->setProperty ("worstTimeMs", statistics.worstTime * 1000.0);
+    object->setProperty ("lastLoad", statistics.lastLoad);
+    object->setProperty ("averageLoad", statistics.averageLoad);
+    object->setProperty ("worstLoad", statistics.worstLoad);
+    object->setProperty ("numOverruns", statistics.numOverruns);
+    object->setProperty ("numGaps", statistics.numGaps);
+    object->setProperty ("loadHistogram", histogramValues);
+    return JSON::toString (var (object.get()), true);
+}
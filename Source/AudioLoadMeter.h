@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    AudioLoadMeter.h
+    Created: 18 Oct 2026 8:56:15pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include <atomic>
+
+using namespace juce;
+//==============================================================================
+/*
+    Measures how long the audio callbacks take. The load is the time a callback
+    takes as a fraction of the time that its buffer lasts.
+
+    The audio thread only writes atomics, so it never locks or allocates. Any
+    other thread can read the statistics at any time.
+
+    Possible dropouts are counted two ways. An overrun is a callback that took
+    longer than its buffer lasts. A gap is a callback that started more than
+    Global::loadMeterGapFactor buffer periods after the previous one, which
+    points at a stall somewhere other than in the callback itself.
+*/
+class AudioLoadMeter
+{
+public:
+    // the load is counted in bins of 10 %, the last bin holds all callbacks over 100 %
+    static const int numHistogramBins = 11;
+
+    struct Statistics
+    {
+        int64 numCallbacks = 0;
+        double lastTime = 0, worstTime = 0; // in seconds
+        double lastLoad = 0, averageLoad = 0, worstLoad = 0;
+        int64 numOverruns = 0, numGaps = 0;
+        int64 histogram[numHistogramBins] = {};
+    };
+
+    // measures the lifetime of the object, put it at the start of the callback
+    class ScopedMeasurement
+    {
+    public:
+        ScopedMeasurement (AudioLoadMeter& meter, int numSamples)
+            : meter (meter), numSamples (numSamples), startTicks (Time::getHighResolutionTicks()) {};
+        ~ScopedMeasurement() { meter.addCallback (startTicks, Time::getHighResolutionTicks(), numSamples); };
+
+    private:
+        AudioLoadMeter& meter;
+        int numSamples;
+        int64 startTicks;
+    };
+
+    AudioLoadMeter();
+    ~AudioLoadMeter();
+
+    // starts counting again, call while there are no callbacks
+    void prepare (double sampleRate);
+
+    // called from the audio thread
+    void addCallback (int64 startTicks, int64 endTicks, int numSamples);
+
+    Statistics getStatistics() const;
+
+    String toJSON() const;
+
+private:
+    std::atomic<double> fs { 44100.0 };
+    int64 previousStartTicks = 0;
+    double previousPeriod = 0;
+
+    std::atomic<int64> numCallbacks { 0 };
+    std::atomic<double> lastTime { 0 }, worstTime { 0 };
+    std::atomic<double> lastLoad { 0 }, averageLoad { 0 }, worstLoad { 0 };
+    std::atomic<int64> numOverruns { 0 }, numGaps { 0 };
+    std::atomic<int64> histogram[numHistogramBins];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioLoadMeter)
+};
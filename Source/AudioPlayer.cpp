@@ -16,14 +16,26 @@ AudioPlayer::AudioPlayer() : AppComponent ("Audio", false)
 {
     // In your constructor, you should add any child components, and
     // initialise any special settings that your component needs.
-    prevInputs.resize (Global::numCoeffs * 0.5);
-    prevOutputs.resize (Global::numCoeffs * 0.5);
+    filterCoefficients.resize (Global::numCoeffs);
+    block.resize (Global::audioBlockSize);
 
-    noiseButton = std::make_unique<TextButton> ("Noise");
-    addAndMakeVisible (noiseButton.get());
-    defaultButtonColour = noiseButton->getLookAndFeel().findColour (TextButton::buttonColourId);
-    noiseButton->addListener (this);
-    noiseButton->setColour (TextButton::buttonColourId, playNoise ? Colours::green : defaultButtonColour);
+    for (int type = 0; type < SignalGenerator::numTypes; ++type)
+        generators.push_back (SignalGenerator::create (static_cast<SignalGenerator::Type> (type)));
+
+    playButton = std::make_unique<TextButton> ("Play");
+    addAndMakeVisible (playButton.get());
+    defaultButtonColour = playButton->getLookAndFeel().findColour (TextButton::buttonColourId);
+    playButton->addListener (this);
+    playButton->setColour (TextButton::buttonColourId, play ? Colours::green : defaultButtonColour);
+
+    sourceBox = std::make_unique<ComboBox> ();
+    for (int type = 0; type < SignalGenerator::numTypes; ++type)
+        sourceBox->addItem (SignalGenerator::getName (static_cast<SignalGenerator::Type> (type)), type + 1);
+    sourceBox->addItem ("Live input", liveInputIdx + 1);
+    sourceBox->addItem ("Audio file", audioFileIdx + 1);
+    sourceBox->setSelectedId (sourceIdx + 1, dontSendNotification);
+    sourceBox->addListener (this);
+    addAndMakeVisible (sourceBox.get());
 
     
     scaleButton = std::make_unique<TextButton> ("Auto scale");
@@ -31,10 +43,28 @@ AudioPlayer::AudioPlayer() : AppComponent ("Audio", false)
     scaleButton->addListener (this);
     scaleButton->setColour (TextButton::buttonColourId, scaleOutput ? Colours::green : defaultButtonColour);
 
+    openButton = std::make_unique<TextButton> ("Open file");
+    addAndMakeVisible (openButton.get());
+    openButton->addListener (this);
+
+    renderButton = std::make_unique<TextButton> ("Render files");
+    addAndMakeVisible (renderButton.get());
+    renderButton->addListener (this);
+    renderer.addChangeListener (this);
+
+    readAheadThread.startThread (3);
+
+    loadLabel = std::make_unique<Label>();
+    loadLabel->setJustificationType (Justification::centredLeft);
+    addAndMakeVisible (loadLabel.get());
+    startTimerHz (Global::loadMeterRefreshRate);
 }
 
 AudioPlayer::~AudioPlayer()
 {
+    renderer.removeChangeListener (this);
+    transportSource.setSource (nullptr);
+    readAheadThread.stopThread (1000);
 }
 
 void AudioPlayer::paint (juce::Graphics& g)
@@ -54,38 +84,206 @@ void AudioPlayer::resized()
     // components that your component contains..
     Rectangle<int> totArea = getLocalBounds();
     totArea.reduce (Global::margin, Global::margin);
-    noiseButton->setBounds (totArea.removeFromRight (100));
+    Rectangle<int> fileArea = totArea.removeFromBottom ((totArea.getHeight() - Global::margin) * 0.5);
+    totArea.removeFromBottom (Global::margin);
+
+    renderButton->setBounds (fileArea.removeFromRight (100));
+    fileArea.removeFromRight(Global::margin);
+    openButton->setBounds (fileArea.removeFromRight (100));
+    fileArea.removeFromRight(Global::margin);
+    loadLabel->setBounds (fileArea);
+
+    playButton->setBounds (totArea.removeFromRight (80));
+    totArea.removeFromRight(Global::margin);
+    scaleButton->setBounds (totArea.removeFromRight (80));
     totArea.removeFromRight(Global::margin);
-    scaleButton->setBounds (totArea.removeFromRight (100));
+    sourceBox->setBounds (totArea.removeFromRight (110));
 }
 
 void AudioPlayer::buttonClicked (Button* button)
 {
-    if (button == noiseButton.get())
+    if (button == playButton.get())
     {
-    playNoise = !playNoise;
-    noiseButton->setColour (TextButton::buttonColourId, playNoise ? Colours::green : defaultButtonColour);
+        play = !play;
+        playButton->setColour (TextButton::buttonColourId, play ? Colours::green : defaultButtonColour);
     }
     else if (button == scaleButton.get())
     {
         scaleOutput = !scaleOutput;
         scaleButton->setColour (TextButton::buttonColourId, scaleOutput ? Colours::green : defaultButtonColour);
     }
+    else if (button == openButton.get())
+    {
+        fileChooser = std::make_unique<FileChooser> ("Open an audio file", File(), renderer.getFormatManager().getWildcardForAllFormats());
+        fileChooser->launchAsync (FileBrowserComponent::openMode | FileBrowserComponent::canSelectFiles,
+                                  [this] (const FileChooser& chooser) {
+                                      if (chooser.getResult() != File())
+                                          openFile (chooser.getResult());
+                                  });
+    }
+    else if (button == renderButton.get())
+    {
+        // the files are rendered with the coefficients at the moment they are chosen
+        fileChooser = std::make_unique<FileChooser> ("Render audio files through the filter", File(), renderer.getFormatManager().getWildcardForAllFormats());
+        fileChooser->launchAsync (FileBrowserComponent::openMode | FileBrowserComponent::canSelectFiles | FileBrowserComponent::canSelectMultipleItems,
+                                  [this] (const FileChooser& chooser) {
+                                      renderer.render (chooser.getResults(), coefficients.getVector());
+                                      changeListenerCallback (&renderer);
+                                  });
+    }
+}
+
+void AudioPlayer::changeListenerCallback (ChangeBroadcaster* source)
+{
+    int numFilesLeft = renderer.getNumFilesLeft();
+    renderButton->setButtonText (numFilesLeft == 0 ? "Render files" : "Rendering (" + String (numFilesLeft) + ")");
+}
+
+void AudioPlayer::timerCallback()
+{
+    AudioLoadMeter::Statistics statistics = loadMeter.getStatistics();
+    loadLabel->setText ("CPU " + String (statistics.averageLoad * 100.0, 1) + "%, max " + String (statistics.worstLoad * 100.0, 1) + "%",
+                        dontSendNotification);
+
+    int64 numDropouts = statistics.numOverruns + statistics.numGaps;
+    if (numDropouts != numDropoutsLogged) // fewer after the meter was prepared again
+    {
+        if (numDropouts > numDropoutsLogged)
+            Logger::writeToLog ("Audio load: " + loadMeter.toJSON());
+        numDropoutsLogged = numDropouts;
+    }
+}
+
+void AudioPlayer::openFile (const File& file)
+{
+    std::unique_ptr<AudioFormatReader> reader (renderer.getFormatManager().createReaderFor (file));
+    if (reader == nullptr)
+    {
+        Logger::writeToLog ("Could not read " + file.getFullPathName());
+        return;
+    }
+
+    // the transport source locks the audio thread out while it changes source
+    double fileSampleRate = reader->sampleRate;
+    int numFileChannels = static_cast<int> (reader->numChannels);
+    auto newSource = std::make_unique<AudioFormatReaderSource> (reader.release(), true);
+    newSource->setLooping (true);
+
+    transportSource.setSource (nullptr);
+    readerSource = std::move (newSource);
+    transportSource.setSource (readerSource.get(), Global::fileReadAheadSize, &readAheadThread,
+                               fileSampleRate, jmax (2, numFileChannels));
+    transportSource.start();
+
+    openButton->setButtonText (file.getFileName());
+    sourceBox->setSelectedId (audioFileIdx + 1);
+}
+
+void AudioPlayer::comboBoxChanged (ComboBox* comboBox)
+{
+    sourceIdx = sourceBox->getSelectedId() - 1;
+}
+
+void AudioPlayer::setCoefficients (const FilterModel::Snapshot& snapshot, uint32 changeMaskToSet)
+{
+    AppComponent::setCoefficients (snapshot, changeMaskToSet);
+    const SpinLock::ScopedLockType lock (coefficientLock);
+    for (int i = 0; i < Global::numCoeffs; ++i)
+        filterCoefficients[i] = snapshot[i];
+}
+
+void AudioPlayer::prepareToPlay (double sampleRate, int numChannels, int samplesPerBlockExpected)
+{
+    transportSource.prepareToPlay (samplesPerBlockExpected, sampleRate);
+    loadMeter.prepare (sampleRate);
+
+    for (auto& generator : generators)
+        generator->prepare (sampleRate);
+
+    // the audio callback is not running while it is being prepared, so the engines can be allocated here
+    filterEngines.resize (jmax (numChannels, 1));
+    resetStates();
+}
+
+void AudioPlayer::releaseResources()
+{
+    transportSource.releaseResources();
 }
 
-void AudioPlayer::calculate()
+void AudioPlayer::resetStates()
 {
-    Random r;
-    output = 0;
-    prevInputs[writePointer] = r.nextFloat() - 0.5;
-    for (int i = 0; i < Global::numCoeffs * 0.5; ++i)
+    for (auto& filterEngine : filterEngines)
+        filterEngine.reset();
+}
+
+void AudioPlayer::processBlock (AudioBuffer<float>& buffer, int startSample, int numSamples, float gain)
+{
+    // the engines ramp to new coefficients themselves. While the message thread is writing them, the
+    // ones from the previous block are kept, so a half updated set never reaches the filter.
     {
-        output += coefficients[i] * prevInputs[static_cast<int> (writePointer - i + Global::numCoeffs * 0.5) % static_cast<int> (Global::numCoeffs * 0.5)];
+        const SpinLock::ScopedTryLockType lock (coefficientLock);
+        if (lock.isLocked())
+            for (auto& filterEngine : filterEngines)
+                filterEngine.setCoefficients (filterCoefficients);
     }
-    for (int i = Global::numCoeffs * 0.5 + 1; i < Global::numCoeffs; ++i)
+
+    int idx = sourceIdx;
+    if (idx == liveInputIdx)
+    {
+        // the device input is in the buffer already
+        currentSourceIdx = idx;
+        filterInPlace (buffer, startSample, numSamples, gain);
+        return;
+    }
+    if (idx == audioFileIdx)
+    {
+        // channels the file does not have stay silent
+        currentSourceIdx = idx;
+        buffer.clear (startSample, numSamples);
+        transportSource.getNextAudioBlock (AudioSourceChannelInfo (&buffer, startSample, numSamples));
+        filterInPlace (buffer, startSample, numSamples, gain);
+        return;
+    }
+
+    // a test signal that is selected again starts from the beginning
+    if (idx != currentSourceIdx)
+    {
+        generators[idx]->reset();
+        currentSourceIdx = idx;
+    }
+
+    // the test signals are played 6 dB below the input
+    gain *= 0.5f;
+
+    // in chunks that fit in the preallocated block, so nothing is allocated on the audio thread
+    float* output = buffer.getWritePointer (0, startSample);
+    int n = 0;
+    while (n < numSamples)
+    {
+        int numToProcess = jmin (Global::audioBlockSize, numSamples - n);
+        generators[idx]->process (&block[0], numToProcess);
+        filterEngines[0].process (&block[0], &block[0], numToProcess);
+        
+        for (int i = 0; i < numToProcess; ++i)
+            output[n + i] = Global::outputLimit (block[i] * gain);
+        n += numToProcess;
+    }
+
+    // the same signal on all channels
+    for (int ch = 1; ch < buffer.getNumChannels(); ++ch)
+        buffer.copyFrom (ch, startSample, buffer, 0, startSample, numSamples);
+}
+
+void AudioPlayer::filterInPlace (AudioBuffer<float>& buffer, int startSample, int numSamples, float gain)
+{
+    const int numChannels = jmin (buffer.getNumChannels(), static_cast<int> (filterEngines.size()));
+    for (int ch = 0; ch < numChannels; ++ch)
     {
-        output += coefficients[i] * prevOutputs[static_cast<int> (writePointer - (i - Global::numCoeffs * 0.5) + Global::numCoeffs * 0.5 ) % static_cast<int> (Global::numCoeffs * 0.5)];
+        float* samples = buffer.getWritePointer (ch, startSample);
+        filterEngines[ch].process (samples, samples, numSamples);
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = Global::outputLimit (samples[i] * gain);
     }
-    prevOutputs[writePointer] = output;
-    writePointer = (writePointer + 1) % static_cast<int> (Global::numCoeffs * 0.5);
+    for (int ch = numChannels; ch < buffer.getNumChannels(); ++ch)
+        buffer.clear (ch, startSample, numSamples);
 }
@@ -13,11 +13,15 @@
 #include <JuceHeader.h>
 #include "Global.h"
 #include "AppComponent.h"
+#include "FilterEngine.h"
+#include "SignalGenerator.h"
+#include "OfflineRenderer.h"
+#include "AudioLoadMeter.h"
 
 //==============================================================================
 /*
 */
-class AudioPlayer  : public AppComponent, public Button::Listener
+class AudioPlayer  : public AppComponent, public Button::Listener, public ComboBox::Listener, public ChangeListener, public Timer
 {
 public:
     AudioPlayer();
@@ -26,30 +30,77 @@ public:
     void paint (juce::Graphics&) override;
     void resized() override;
     
-    void calculate() override;
+    // called from the audio thread before it calls processBlock(), with the number of channels of its buffers
+    void prepareToPlay (double sampleRate, int numChannels, int samplesPerBlockExpected);
+    void releaseResources();
+
+    // Called from the audio thread. Filters the device input or the audio file in place, or fills
+    // all channels with the filtered test signal.
+    void processBlock (AudioBuffer<float>& buffer, int startSample, int numSamples, float gain);
+    
+    // processBlock() runs on the audio thread, so it uses its own copy of the coefficients instead of the snapshot
+    void setCoefficients (const FilterModel::Snapshot& snapshot, uint32 changeMaskToSet) override;
+    bool needsRefresh (uint32 changeMask) override { return false; };
     
     void buttonClicked (Button* button) override;
+    void comboBoxChanged (ComboBox* comboBox) override;
+    void changeListenerCallback (ChangeBroadcaster* source) override;
+
+    // shows the load of the audio callback, and logs the statistics when there are new dropouts
+    void timerCallback() override;
+
+    AudioLoadMeter& getLoadMeter() { return loadMeter; };
 
-    bool shouldPlayNoise() { return playNoise; };
+    bool shouldPlay() { return play; };
     bool shouldScaleOutput() { return scaleOutput; };
-    float getOutput() { return output; };
     
-    void resetStates() { prevOutputs.clear(); prevOutputs.resize (Global::numCoeffs * 0.5, 0); };
+    void resetStates();
+
+    // the indices of the live input and the audio file in the source box, after the signal generators
+    static const int liveInputIdx = SignalGenerator::numTypes;
+    static const int audioFileIdx = SignalGenerator::numTypes + 1;
     
     
     
 private:
-    std::unique_ptr<TextButton> noiseButton;
+    // filters all channels where they are
+    void filterInPlace (AudioBuffer<float>& buffer, int startSample, int numSamples, float gain);
+
+    void openFile (const File& file);
+
+    std::unique_ptr<TextButton> playButton;
     std::unique_ptr<TextButton> scaleButton;
 
-    bool playNoise = false;
+    std::unique_ptr<ComboBox> sourceBox;
+    std::unique_ptr<TextButton> openButton;
+    std::unique_ptr<TextButton> renderButton;
+    std::unique_ptr<FileChooser> fileChooser;
+    std::unique_ptr<Label> loadLabel;
+
+    bool play = false;
     bool scaleOutput = true;
     Colour defaultButtonColour;
 
-    std::vector<double> prevInputs;
-    std::vector<double> prevOutputs;
-    int readPointer = 1;
-    int writePointer = 1;
-    float output = 0;
+    std::vector<double> filterCoefficients;
+    SpinLock coefficientLock;
+    std::vector<FilterEngine> filterEngines; // one for every channel
+
+    // all generators are made up front, switching between them only changes the index
+    std::vector<std::unique_ptr<SignalGenerator>> generators;
+    std::atomic<int> sourceIdx { SignalGenerator::whiteNoise };
+    int currentSourceIdx = SignalGenerator::whiteNoise; // only used by the audio thread
+
+    std::vector<double> block;
+
+    OfflineRenderer renderer;
+
+    AudioLoadMeter loadMeter;
+    int64 numDropoutsLogged = 0;
+
+    // the file is read ahead of the playback position on its own thread, so the audio thread does not wait for the disk
+    TimeSliceThread readAheadThread { "Audio file read-ahead" };
+    std::unique_ptr<AudioFormatReaderSource> readerSource;
+    AudioTransportSource transportSource;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioPlayer)
 };
@@ -64,6 +64,15 @@ void CoefficientComponent::resized()
     value.setBounds (valueArea.reduced (Global::margin * 0.75));
 }
 
+void CoefficientComponent::setCoefficient (double coefficientToSet)
+{
+    if (isA0)
+        return;
+    
+    // don't notify the listeners, the caller takes care of updating the other components
+    value.setText (coefficientToSet == 0 ? "" : String (coefficientToSet), false);
+}
+
 void CoefficientComponent::mouseDown (const MouseEvent& e)
 {
     curX = e.x;
@@ -27,6 +27,7 @@ public:
     void resized() override;
 
     double getCoefficient() { return isA0 ? 1 : value.getText().getDoubleValue(); };
+    void setCoefficient (double coefficientToSet);
 
     TextEditor& getTextEditor() { return value; };
     
@@ -79,6 +79,15 @@ void Coefficientlist::updateCoeff (int idx)
         coefficients[idx] = coeffComps[idx]->getCoefficient();
 }
 
+void Coefficientlist::setCoefficients (const std::vector<double>& coefficientsToSet)
+{
+    for (int i = 0; i < Global::numCoeffs; ++i)
+    {
+        coeffComps[i]->setCoefficient (coefficientsToSet[i]);
+        coefficients[i] = coeffComps[i]->getCoefficient();
+    }
+}
+
 void Coefficientlist::refreshCoefficients()
 {
     for (int i = 0; i < Global::numCoeffs; ++i)
@@ -42,6 +42,8 @@ public:
     
     void refreshCoefficients();
     
+    void setCoefficients (const std::vector<double>& coefficientsToSet);
+    
     TextEditor& getTextEditor (int idx) { return coeffComps[idx]->getTextEditor(); };
     
 private:
@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+    FilterBank.cpp
+    Created: 18 Oct 2026 9:00:22pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "FilterBank.h"
+
+static_assert (FilterBank::order == 5, "the kernel in processGroup() is written out for a fifth order filter");
+
+//==============================================================================
+// Processes a range of groups for one call of process().
+class FilterBank::Worker : public ThreadPoolJob
+{
+public:
+    Worker (FilterBank& owner) : ThreadPoolJob ("Filter bank"), owner (owner) {};
+
+    void setRange (float* const* channelsToSet, int firstGroupToSet, int lastGroupToSet, int numSamplesToSet)
+    {
+        channels = channelsToSet;
+        firstGroup = firstGroupToSet;
+        lastGroup = lastGroupToSet;
+        numSamples = numSamplesToSet;
+    }
+
+    JobStatus runJob() override
+    {
+        owner.processGroups (channels, firstGroup, lastGroup, numSamples);
+        if (--owner.numWorkersLeft == 0)
+            owner.workersDone.signal();
+        return jobHasFinished;
+    }
+
+private:
+    FilterBank& owner;
+    float* const* channels = nullptr;
+    int firstGroup = 0, lastGroup = 0, numSamples = 0;
+};
+
+//==============================================================================
+FilterBank::FilterBank (int numChannels, int numThreads)
+{
+    if (numThreads > 1)
+    {
+        threadPool = std::make_unique<ThreadPool> (numThreads - 1);
+        for (int i = 0; i < numThreads - 1; ++i)
+            workers.push_back (std::make_unique<Worker> (*this));
+    }
+    setNumChannels (numChannels);
+}
+
+FilterBank::~FilterBank()
+{
+    if (threadPool != nullptr)
+        threadPool->removeAllJobs (true, 1000);
+}
+
+void FilterBank::setNumChannels (int numChannelsToSet)
+{
+    numChannels = numChannelsToSet;
+    groups.assign ((numChannels + numLanes - 1) / numLanes, Group());
+    for (auto& group : groups)
+    {
+        for (int k = 0; k <= order; ++k)
+            for (int l = 0; l < numLanes; ++l)
+            {
+                group.b[k][l] = 0;
+                group.a[k][l] = 0;
+            }
+    }
+    reset();
+}
+
+void FilterBank::setCoefficients (const std::vector<double>& coefficientsToSet)
+{
+    for (int ch = 0; ch < numChannels; ++ch)
+        setCoefficients (ch, coefficientsToSet);
+}
+
+void FilterBank::setCoefficients (int channel, const std::vector<double>& coefficientsToSet)
+{
+    Group& group = groups[channel / numLanes];
+    int l = channel % numLanes;
+    for (int k = 0; k <= order; ++k)
+    {
+        group.b[k][l] = coefficientsToSet[k];
+        group.a[k][l] = coefficientsToSet[k + order + 1];
+    }
+}
+
+void FilterBank::reset()
+{
+    for (auto& group : groups)
+        for (int k = 0; k < order; ++k)
+            for (int l = 0; l < numLanes; ++l)
+            {
+                group.xState[k][l] = 0;
+                group.yState[k][l] = 0;
+            }
+}
+
+void FilterBank::process (float* const* channels, int numSamples)
+{
+    int64 startTicks = Time::getHighResolutionTicks();
+    int numGroups = static_cast<int> (groups.size());
+
+    // every thread gets at least Global::filterBankMinChannelsPerThread channels
+    int numParts = jmin (static_cast<int> (workers.size()) + 1, numChannels / Global::filterBankMinChannelsPerThread);
+    if (numParts <= 1)
+    {
+        processGroups (channels, 0, numGroups, numSamples);
+    }
+    else
+    {
+        int groupsPerPart = (numGroups + numParts - 1) / numParts;
+        numWorkersLeft = numParts - 1;
+        for (int p = 1; p < numParts; ++p)
+        {
+            workers[p - 1]->setRange (channels, jmin (p * groupsPerPart, numGroups), jmin ((p + 1) * groupsPerPart, numGroups), numSamples);
+            threadPool->addJob (workers[p - 1].get(), false);
+        }
+        processGroups (channels, 0, jmin (groupsPerPart, numGroups), numSamples);
+        workersDone.wait();
+
+        // the pool only lets go of a job after runJob() has returned, and a job it still holds cannot be added again
+        for (int p = 1; p < numParts; ++p)
+            threadPool->waitForJobToFinish (workers[p - 1].get(), -1);
+    }
+
+    totalTicks += Time::getHighResolutionTicks() - startTicks;
+    totalChannelSamples += static_cast<int64> (numChannels) * numSamples;
+}
+
+double FilterBank::getChannelSamplesPerSecond() const
+{
+    return totalTicks > 0 ? totalChannelSamples / Time::highResolutionTicksToSeconds (totalTicks) : 0.0;
+}
+
+void FilterBank::processGroups (float* const* channels, int firstGroup, int lastGroup, int numSamples)
+{
+    for (int g = firstGroup; g < lastGroup; ++g)
+        processGroup (groups[g], channels + g * numLanes, jmin (numLanes, numChannels - g * numLanes), numSamples);
+}
+
+void FilterBank::processGroup (Group& group, float* const* channels, int numChannelsInGroup, int numSamples)
+{
+    // local copies, so the compiler knows nothing else points at them and keeps them in registers
+    double b0[numLanes], b1[numLanes], b2[numLanes], b3[numLanes], b4[numLanes], b5[numLanes];
+    double a1[numLanes], a2[numLanes], a3[numLanes], a4[numLanes], a5[numLanes];
+    double x1[numLanes], x2[numLanes], x3[numLanes], x4[numLanes], x5[numLanes];
+    double y1[numLanes], y2[numLanes], y3[numLanes], y4[numLanes], y5[numLanes];
+    for (int l = 0; l < numLanes; ++l)
+    {
+        b0[l] = group.b[0][l]; b1[l] = group.b[1][l]; b2[l] = group.b[2][l]; b3[l] = group.b[3][l]; b4[l] = group.b[4][l]; b5[l] = group.b[5][l];
+        a1[l] = group.a[1][l]; a2[l] = group.a[2][l]; a3[l] = group.a[3][l]; a4[l] = group.a[4][l]; a5[l] = group.a[5][l];
+        x1[l] = group.xState[0][l]; x2[l] = group.xState[1][l]; x3[l] = group.xState[2][l]; x4[l] = group.xState[3][l]; x5[l] = group.xState[4][l];
+        y1[l] = group.yState[0][l]; y2[l] = group.yState[1][l]; y3[l] = group.yState[2][l]; y4[l] = group.yState[3][l]; y5[l] = group.yState[4][l];
+    }
+
+    // the samples of the group interleaved, lanes without a channel filter silence
+    double tile[Global::filterBankTileSize][numLanes];
+
+    for (int start = 0; start < numSamples; start += Global::filterBankTileSize)
+    {
+        int numToProcess = jmin (Global::filterBankTileSize, numSamples - start);
+
+        for (int l = 0; l < numLanes; ++l)
+        {
+            if (l < numChannelsInGroup)
+                for (int i = 0; i < numToProcess; ++i)
+                    tile[i][l] = channels[l][start + i];
+            else
+                for (int i = 0; i < numToProcess; ++i)
+                    tile[i][l] = 0.0;
+        }
+
+        for (int i = 0; i < numToProcess; ++i)
+        {
+            for (int l = 0; l < numLanes; ++l)
+            {
+                double x0 = tile[i][l];
+                double y0 = b0[l] * x0 + b1[l] * x1[l] + b2[l] * x2[l] + b3[l] * x3[l] + b4[l] * x4[l] + b5[l] * x5[l]
+                          + a1[l] * y1[l] + a2[l] * y2[l] + a3[l] * y3[l] + a4[l] * y4[l] + a5[l] * y5[l];
+
+                x5[l] = x4[l]; x4[l] = x3[l]; x3[l] = x2[l]; x2[l] = x1[l]; x1[l] = x0;
+                y5[l] = y4[l]; y4[l] = y3[l]; y3[l] = y2[l]; y2[l] = y1[l]; y1[l] = y0;
+
+                tile[i][l] = y0;
+            }
+        }
+
+        for (int l = 0; l < numChannelsInGroup; ++l)
+            for (int i = 0; i < numToProcess; ++i)
+                channels[l][start + i] = static_cast<float> (tile[i][l]);
+    }
+
+    for (int l = 0; l < numLanes; ++l)
+    {
+        group.xState[0][l] = x1[l]; group.xState[1][l] = x2[l]; group.xState[2][l] = x3[l]; group.xState[3][l] = x4[l]; group.xState[4][l] = x5[l];
+        group.yState[0][l] = y1[l]; group.yState[1][l] = y2[l]; group.yState[2][l] = y3[l]; group.yState[3][l] = y4[l]; group.yState[4][l] = y5[l];
+    }
+}
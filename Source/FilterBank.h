@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    FilterBank.h
+    Created: 18 Oct 2026 9:00:22pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include "FilterEngine.h"
+#include <atomic>
+
+using namespace juce;
+//==============================================================================
+/*
+    Runs the difference equation of FilterEngine over many channels, with the
+    same coefficients on all of them or a different set per channel.
+
+    The channels are processed in groups of numLanes. The coefficients and
+    states of a group are stored lane by lane (structure of arrays), and the
+    samples are interleaved into a small tile, so the recursion handles all
+    channels of a group at once and is vectorised by the compiler. With enough
+    channels the groups are split over a thread pool, and the calling thread
+    processes a part as well.
+
+    Coefficient changes take effect at once, there is no ramp like in FilterEngine.
+*/
+class FilterBank
+{
+public:
+    // numThreads includes the calling thread, 1 processes everything on the calling thread
+    FilterBank (int numChannels = 0, int numThreads = 1);
+    ~FilterBank();
+
+    // allocates, so not from the audio thread. Resets the states and sets all coefficients to 0.
+    void setNumChannels (int numChannelsToSet);
+    int getNumChannels() const { return numChannels; };
+
+    // for all channels
+    void setCoefficients (const std::vector<double>& coefficientsToSet);
+    // for one channel
+    void setCoefficients (int channel, const std::vector<double>& coefficientsToSet);
+
+    void reset();
+
+    // filters getNumChannels() channels in place
+    void process (float* const* channels, int numSamples);
+
+    // of all process() calls so far
+    double getChannelSamplesPerSecond() const;
+
+    static const int numLanes = 4;
+    static const int order = FilterEngine::order;
+
+private:
+    struct Group
+    {
+        double b[order + 1][numLanes];
+        double a[order + 1][numLanes]; // a[0] is not used
+        double xState[order][numLanes];
+        double yState[order][numLanes];
+    };
+    class Worker;
+
+    void processGroups (float* const* channels, int firstGroup, int lastGroup, int numSamples);
+    void processGroup (Group& group, float* const* channels, int numChannelsInGroup, int numSamples);
+
+    int numChannels = 0;
+    std::vector<Group> groups;
+
+    std::unique_ptr<ThreadPool> threadPool;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<int> numWorkersLeft { 0 };
+    WaitableEvent workersDone;
+
+    int64 totalTicks = 0;
+    int64 totalChannelSamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FilterBank)
+};
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    FilterEngine.cpp
+    Created: 18 Oct 2026 8:29:02pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "FilterEngine.h"
+
+static_assert (Global::coefficientRampLength % Global::coefficientRampStep == 0, "the ramp has to end on a step");
+
+//==============================================================================
+FilterEngine::FilterEngine()
+{
+    for (int k = 0; k <= order; ++k)
+    {
+        b[k] = 0;
+        a[k] = 0;
+        bTarget[k] = 0;
+        aTarget[k] = 0;
+    }
+    reset();
+}
+
+void FilterEngine::setCoefficients (const std::vector<double>& coefficientsToSet, bool smooth)
+{
+    smooth = smooth && hasCoefficients;
+
+    bool changed = false;
+    for (int k = 0; k <= order; ++k)
+    {
+        changed = changed || bTarget[k] != coefficientsToSet[k] || aTarget[k] != coefficientsToSet[k + order + 1];
+        bTarget[k] = coefficientsToSet[k];
+        aTarget[k] = coefficientsToSet[k + order + 1];
+    }
+    hasCoefficients = true;
+
+    if (! smooth)
+    {
+        for (int k = 0; k <= order; ++k)
+        {
+            b[k] = bTarget[k];
+            a[k] = aTarget[k];
+        }
+        updateOrders();
+        rampPos = Global::coefficientRampLength;
+        return;
+    }
+
+    if (! changed)
+        return;
+
+    // a new ramp starts from wherever the previous one was
+    for (int k = 0; k <= order; ++k)
+    {
+        bStart[k] = b[k];
+        aStart[k] = a[k];
+    }
+    interpolateReflection = toReflection (aStart, kStart) && toReflection (aTarget, kTarget);
+    rampPos = 0;
+}
+
+void FilterEngine::reset()
+{
+    for (int k = 0; k < order; ++k)
+    {
+        xState[k] = 0;
+        yState[k] = 0;
+    }
+}
+
+void FilterEngine::process (const double* input, double* output, int numSamples)
+{
+    processBlock (input, output, numSamples);
+}
+
+void FilterEngine::process (const float* input, float* output, int numSamples)
+{
+    processBlock (input, output, numSamples);
+}
+
+template <typename SampleType>
+void FilterEngine::processBlock (const SampleType* input, SampleType* output, int numSamples)
+{
+    int n = 0;
+    while (n < numSamples && rampPos < Global::coefficientRampLength)
+    {
+        int stepPos = rampPos % Global::coefficientRampStep;
+        if (stepPos == 0)
+            updateRamp();
+
+        int numToProcess = jmin (Global::coefficientRampStep - stepPos, numSamples - n);
+        processSamples (input + n, output + n, numToProcess);
+        rampPos += numToProcess;
+        n += numToProcess;
+    }
+
+    if (n < numSamples)
+        processSamples (input + n, output + n, numSamples - n);
+}
+
+void FilterEngine::updateRamp()
+{
+    // the last step of the ramp uses the target itself
+    int endPos = rampPos + Global::coefficientRampStep;
+    if (endPos >= Global::coefficientRampLength)
+    {
+        for (int k = 0; k <= order; ++k)
+        {
+            b[k] = bTarget[k];
+            a[k] = aTarget[k];
+        }
+        updateOrders();
+        return;
+    }
+
+    double t = static_cast<double> (endPos) / Global::coefficientRampLength;
+    for (int k = 0; k <= order; ++k)
+        b[k] = bStart[k] + t * (bTarget[k] - bStart[k]);
+
+    if (interpolateReflection)
+    {
+        double k[order];
+        for (int i = 0; i < order; ++i)
+            k[i] = kStart[i] + t * (kTarget[i] - kStart[i]);
+        fromReflection (k, a);
+    }
+    else
+    {
+        for (int i = 1; i <= order; ++i)
+            a[i] = aStart[i] + t * (aTarget[i] - aStart[i]);
+    }
+    updateOrders();
+}
+
+void FilterEngine::updateOrders()
+{
+    numeratorOrder = 0;
+    denominatorOrder = 0;
+    for (int k = 1; k <= order; ++k)
+    {
+        if (b[k] != 0)
+            numeratorOrder = k;
+        if (a[k] != 0)
+            denominatorOrder = k;
+    }
+}
+
+bool FilterEngine::toReflection (const double* aToConvert, double* k)
+{
+    // step-down recursion: the last coefficient of every order is its reflection coefficient
+    double p[order + 1];
+    p[0] = 1.0;
+    for (int i = 1; i <= order; ++i)
+        p[i] = -aToConvert[i];
+
+    for (int m = order; m >= 1; --m)
+    {
+        double km = p[m];
+        if (! (std::abs (km) < 1.0)) // also catches NaN
+            return false;
+        k[m - 1] = km;
+
+        double scale = 1.0 / (1.0 - km * km);
+        double q[order + 1];
+        for (int i = 1; i < m; ++i)
+            q[i] = (p[i] - km * p[m - i]) * scale;
+        for (int i = 1; i < m; ++i)
+            p[i] = q[i];
+    }
+    return true;
+}
+
+void FilterEngine::fromReflection (const double* k, double* aToSet)
+{
+    // step-up recursion, the inverse of toReflection()
+    double p[order + 1];
+    p[0] = 1.0;
+    for (int m = 1; m <= order; ++m)
+    {
+        double q[order + 1];
+        for (int i = 1; i < m; ++i)
+            q[i] = p[i] + k[m - 1] * p[m - i];
+        for (int i = 1; i < m; ++i)
+            p[i] = q[i];
+        p[m] = k[m - 1];
+    }
+
+    for (int i = 1; i <= order; ++i)
+        aToSet[i] = -p[i];
+}
+
+template <typename SampleType>
+void FilterEngine::processSamples (const SampleType* input, SampleType* output, int numSamples)
+{
+    IIRKernelTable<SampleType>::get (numeratorOrder, denominatorOrder) (b, a, xState, yState, input, output, numSamples);
+}
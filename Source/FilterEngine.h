@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    FilterEngine.h
+    Created: 18 Oct 2026 8:29:02pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include "IIRKernel.h"
+
+//==============================================================================
+/*
+    Runs the difference equation
+        y[n] = b0 x[n] + ... + b5 x[n-5] + a1 y[n-1] + ... + a5 y[n-5]
+    over blocks of samples. Blocks are run by the IIRKernel of the highest
+    nonzero orders of the coefficients, so lower order filters are cheaper.
+
+    New coefficients are ramped in over Global::coefficientRampLength samples
+    and updated every Global::coefficientRampStep samples, so changes do not
+    click. The denominator is interpolated through its reflection coefficients:
+    every filter in between two stable filters is then stable as well, which
+    is not the case when the direct form coefficients are interpolated.
+*/
+class FilterEngine
+{
+public:
+    FilterEngine();
+
+    // the first coefficients after construction are used at once, later ones are ramped in unless smooth is false
+    void setCoefficients (const std::vector<double>& coefficientsToSet, bool smooth = true);
+    void reset();
+
+    // input and output may be the same buffer
+    void process (const double* input, double* output, int numSamples);
+
+    // the same in single precision, for audio device buffers. The filter itself still runs in double precision.
+    void process (const float* input, float* output, int numSamples);
+
+    static const int order = Global::numCoeffs / 2 - 1;
+    static_assert (order == IIRKernel<0, 0>::maxOrder, "the kernels keep the whole state");
+
+private:
+    // splits the block where the ramped coefficients are updated
+    template <typename SampleType>
+    void processBlock (const SampleType* input, SampleType* output, int numSamples);
+
+    // with the current coefficients
+    template <typename SampleType>
+    void processSamples (const SampleType* input, SampleType* output, int numSamples);
+
+    // finds the orders of the kernel for the current coefficients
+    void updateOrders();
+
+    // sets b and a to their values for the ramp step that starts at rampPos
+    void updateRamp();
+
+    // of the denominator 1 - a1 z^-1 - ... - a5 z^-5, returns false if it is not stable
+    static bool toReflection (const double* aToConvert, double* k);
+    static void fromReflection (const double* k, double* aToSet);
+
+    double b[order + 1];
+    double a[order + 1]; // a[0] is not used
+    int numeratorOrder = 0;
+    int denominatorOrder = 0;
+
+    double bStart[order + 1], aStart[order + 1], kStart[order];
+    double bTarget[order + 1], aTarget[order + 1], kTarget[order];
+    bool interpolateReflection = false; // false if either end of the ramp is unstable
+    bool hasCoefficients = false;
+    int rampPos = Global::coefficientRampLength;
+
+    double xState[order]; // x[n-1] ... x[n-5]
+    double yState[order]; // y[n-1] ... y[n-5]
+};
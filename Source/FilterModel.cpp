@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    FilterModel.cpp
+    Created: 18 Oct 2026 8:43:35pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "FilterModel.h"
+
+//==============================================================================
+FilterModel::Snapshot::Snapshot() : coefficients (std::make_shared<const std::vector<double>> (static_cast<size_t> (Global::numCoeffs), 0.0))
+{
+}
+
+FilterModel::Snapshot::Snapshot (std::vector<double> coefficientsToSet) : coefficients (std::make_shared<const std::vector<double>> (std::move (coefficientsToSet)))
+{
+}
+
+//==============================================================================
+FilterModel::FilterModel()
+{
+    // a0 is always 1
+    std::vector<double> coefficients (Global::numCoeffs, 0.0);
+    coefficients[Global::numCoeffs / 2] = 1.0;
+    snapshot = Snapshot (coefficients);
+}
+
+FilterModel::~FilterModel()
+{
+    release (undoHistory);
+    release (redoHistory);
+}
+
+void FilterModel::setCoefficient (int idx, double value)
+{
+    if (snapshot[idx] == value)
+        return;
+
+    std::vector<double> coefficients = snapshot.getVector();
+    coefficients[idx] = value;
+    setSnapshot (Snapshot (std::move (coefficients)), 1u << idx);
+}
+
+void FilterModel::setCoefficients (const std::vector<double>& coefficientsToSet)
+{
+    uint32 changeMask = getChangeMask (snapshot, coefficientsToSet);
+    if (changeMask != 0)
+        setSnapshot (Snapshot (coefficientsToSet), changeMask);
+}
+
+void FilterModel::reset (const std::vector<double>& coefficientsToSet)
+{
+    release (undoHistory);
+    release (redoHistory);
+    endGesture();
+
+    uint32 changeMask = getChangeMask (snapshot, coefficientsToSet);
+    snapshot = Snapshot (coefficientsToSet);
+    if (changeMask != 0)
+        listeners.call ([&] (Listener& listener) { listener.filterModelChanged (snapshot, changeMask); });
+}
+
+uint32 FilterModel::getChangeMask (const std::vector<double>& oldCoefficients, const std::vector<double>& newCoefficients)
+{
+    uint32 changeMask = 0;
+    for (int i = 0; i < Global::numCoeffs; ++i)
+        if (oldCoefficients[i] != newCoefficients[i])
+            changeMask |= 1u << i;
+    return changeMask;
+}
+
+void FilterModel::beginGesture()
+{
+    inGesture = true;
+    gestureHasStep = false;
+}
+
+void FilterModel::endGesture()
+{
+    inGesture = false;
+    gestureHasStep = false;
+}
+
+bool FilterModel::undo()
+{
+    if (undoHistory == nullptr)
+        return false;
+
+    restore (undoHistory, redoHistory);
+    return true;
+}
+
+bool FilterModel::redo()
+{
+    if (redoHistory == nullptr)
+        return false;
+
+    restore (redoHistory, undoHistory);
+    return true;
+}
+
+FilterModel::History FilterModel::push (const History& history, const Snapshot& snapshot)
+{
+    return std::make_shared<const HistoryNode> (HistoryNode { snapshot, history, history == nullptr ? 1 : history->length + 1 });
+}
+
+void FilterModel::release (History& history)
+{
+    // keep a reference to the next node while the current one is destroyed, so nodes are destroyed one at a time
+    while (history != nullptr && history.use_count() == 1)
+    {
+        History next = history->next;
+        history = next;
+    }
+    history = nullptr;
+}
+
+void FilterModel::setSnapshot (const Snapshot& snapshotToSet, uint32 changeMask)
+{
+    // only the first edit of a gesture adds a step
+    if (!gestureHasStep)
+    {
+        undoHistory = push (undoHistory, snapshot);
+        release (redoHistory);
+        gestureHasStep = inGesture;
+    }
+
+    snapshot = snapshotToSet;
+    listeners.call ([&] (Listener& listener) { listener.filterModelChanged (snapshot, changeMask); });
+}
+
+void FilterModel::restore (History& from, History& to)
+{
+    endGesture();
+
+    // the current snapshot goes to the other list, the analysis results of the restored one are usually still in the analysis cache
+    to = push (to, snapshot);
+    Snapshot restored = from->snapshot;
+    from = from->next;
+
+    uint32 changeMask = getChangeMask (snapshot, restored);
+    snapshot = restored;
+    if (changeMask != 0)
+        listeners.call ([&] (Listener& listener) { listener.filterModelChanged (snapshot, changeMask); });
+}
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    FilterModel.h
+    Created: 18 Oct 2026 8:43:35pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+
+using namespace juce;
+//==============================================================================
+/*
+    Owns the coefficients of the filter. Every edit creates a new immutable
+    snapshot, and the listeners are told which coefficients changed with a
+    change mask (bit i is set if coefficient i changed, in the order
+    b0 ... b5, a0 ... a5). Edits that leave all coefficients the same do not
+    notify anyone.
+
+    Every edit also adds the snapshot it replaces to the undo history. All edits
+    between beginGesture() and endGesture() (a drag, or typing in one field)
+    become a single step.
+*/
+class FilterModel
+{
+public:
+    // An immutable set of coefficients. Copies share the same vector.
+    class Snapshot
+    {
+    public:
+        Snapshot();
+        Snapshot (std::vector<double> coefficientsToSet);
+
+        double operator[] (size_t idx) const { return (*coefficients)[idx]; };
+        size_t size() const { return coefficients->size(); };
+
+        const std::vector<double>& getVector() const { return *coefficients; };
+        operator const std::vector<double>&() const { return *coefficients; };
+
+    private:
+        std::shared_ptr<const std::vector<double>> coefficients;
+    };
+
+    static_assert (Global::numCoeffs <= 32, "the change mask needs a bit for every coefficient");
+    static const uint32 numeratorMask = (1u << (Global::numCoeffs / 2)) - 1;
+    static const uint32 denominatorMask = numeratorMask << (Global::numCoeffs / 2);
+    static const uint32 allCoefficientsMask = numeratorMask | denominatorMask;
+
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+        virtual void filterModelChanged (const Snapshot& snapshot, uint32 changeMask) = 0;
+    };
+
+    FilterModel();
+    ~FilterModel();
+
+    const Snapshot& getSnapshot() const { return snapshot; };
+
+    void setCoefficient (int idx, double value);
+    void setCoefficients (const std::vector<double>& coefficientsToSet);
+
+    // starts again from these coefficients with an empty history, for the values the application starts with
+    void reset (const std::vector<double>& coefficientsToSet);
+
+    void addListener (Listener* listener) { listeners.add (listener); };
+    void removeListener (Listener* listener) { listeners.remove (listener); };
+
+    static uint32 getChangeMask (const std::vector<double>& oldCoefficients, const std::vector<double>& newCoefficients);
+
+    // starting a gesture ends the one before it
+    void beginGesture();
+    void endGesture();
+
+    // return false if there is nothing to undo or redo
+    bool undo();
+    bool redo();
+
+    int getNumUndoSteps() const { return undoHistory == nullptr ? 0 : undoHistory->length; };
+    int getNumRedoSteps() const { return redoHistory == nullptr ? 0 : redoHistory->length; };
+
+private:
+    // A persistent list of snapshots, newest first. Nodes never change once they are made, and only the
+    // snapshot pointer is stored, so a step costs one node however often a snapshot appears in the history.
+    struct HistoryNode
+    {
+        Snapshot snapshot;
+        std::shared_ptr<const HistoryNode> next;
+        int length;
+    };
+    typedef std::shared_ptr<const HistoryNode> History;
+
+    static History push (const History& history, const Snapshot& snapshot);
+
+    // drops a history without one destructor call per node on the stack
+    static void release (History& history);
+
+    void setSnapshot (const Snapshot& snapshotToSet, uint32 changeMask);
+    void restore (History& from, History& to);
+
+    Snapshot snapshot;
+    ListenerList<Listener> listeners;
+
+    History undoHistory;
+    History redoHistory;
+    bool inGesture = false;
+    bool gestureHasStep = false; // whether the snapshot from before the gesture is in the undo history already
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FilterModel)
+};
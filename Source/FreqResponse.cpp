@@ -18,21 +18,7 @@ FreqResponse::FreqResponse (double fs) : AppComponent ("Magnitude Response", fal
     // initialise any special settings that your component needs.
     dBData.resize (Global::fftOrder);
     
-    gridLineCoords.resize (32);
-    int m = 10;
-    int n = 0;
-    for (int i = 1; i <= gridLineCoords.size(); ++i)
-    {
-        ++n;
-        double y = m * n;
-        gridLineCoords[i-1] = log(y * (logBase - 1.0) / (fs * 0.5) + 1.0) / log(logBase);
-        if (n % 10 == 0)
-        {
-            m *= 10;
-            n = 0;
-        }
-        
-    }
+    calculateGridLines();
     
     logPlotButton = std::make_unique<TextButton> ();
     logPlotButton->setButtonText (logPlot ? "Lin. plot" : "Log. plot");
@@ -58,6 +44,31 @@ FreqResponse::~FreqResponse()
 {
 }
 
+void FreqResponse::setSampleRate (double sampleRate)
+{
+    fs = sampleRate;
+    calculateGridLines();
+    repaint();
+}
+
+void FreqResponse::calculateGridLines()
+{
+    gridLineCoords.resize (32);
+    int m = 10;
+    int n = 0;
+    for (int i = 1; i <= gridLineCoords.size(); ++i)
+    {
+        ++n;
+        double y = m * n;
+        gridLineCoords[i-1] = log(y * (logBase - 1.0) / (fs * 0.5) + 1.0) / log(logBase);
+        if (n % 10 == 0)
+        {
+            m *= 10;
+            n = 0;
+        }
+    }
+}
+
 void FreqResponse::paint (juce::Graphics& g)
 {
     /* This demo code just fills the component's background and
@@ -260,56 +271,62 @@ void FreqResponse::resized()
 Path FreqResponse::generateResponsePath()
 {
     Path response;
-
-    //response.startNewSubPath(0, -dBData[0] * visualScaling + zeroDbHeight);
-    response.startNewSubPath (Global::margin + Global::axisMargin, -dBData[0] * visualScaling + zeroDbHeight); // draw RT instead of filter magnitude
-    auto spacing = (getWidth() - Global::margin - Global::axisMargin) / static_cast<double> (dBData.size());
-    double x = Global::margin + Global::axisMargin;
-    float newY;
-    for (int y = 0; y < data.size(); y++)
+    const std::vector<double>& positions = sampler.getPositions();
+    double plotWidth = getWidth() - Global::margin - Global::axisMargin;
+    
+    // The grid is finer around peaks and notches, so many samples can end up in one pixel column.
+    // Those are drawn as a single vertical line from the lowest to the highest sample in the column.
+    int column = -1;
+    float columnX = 0, minY = 0, maxY = 0, lastY = 0;
+    for (int i = 0; i < dBData.size(); ++i)
+    {
+        float x = Global::margin + Global::axisMargin + positions[i] * plotWidth;
+        float y = -dBData[i] * visualScaling + zeroDbHeight;
+        if (i == 0)
+        {
+            response.startNewSubPath (x, y);
+        }
+        else if (static_cast<int> (x) == column)
+        {
+            minY = std::min (y, minY);
+            maxY = std::max (y, maxY);
+            lastY = y;
+            continue;
+        }
+        else
+        {
+            if (maxY - minY > 1.0f)
+            {
+                response.lineTo (columnX, minY);
+                response.lineTo (columnX, maxY);
+                response.lineTo (columnX, lastY);
+            }
+            response.lineTo (x, y);
+        }
+        column = static_cast<int> (x);
+        columnX = x;
+        minY = maxY = lastY = y;
+    }
+    if (maxY - minY > 1.0f)
     {
-        newY = -dBData[y] * visualScaling + zeroDbHeight;
-        response.lineTo(x, newY);
-        x += spacing;
+        response.lineTo (columnX, minY);
+        response.lineTo (columnX, maxY);
+        response.lineTo (columnX, lastY);
     }
-    response.lineTo (getWidth(), newY);
     
     return response;
 }
 
 void FreqResponse::calculate()
 {
-    std::complex<double> i (0.0, 1.0);
-    std::complex<double> omega (0.0, 0.0);
-    highestGain = 0;
-    for (int k = 1; k <= Global::fftOrder; ++k)
-    {
-        double linearVal = k / static_cast<double>(Global::fftOrder);
-        if (logPlot)
-            omega.real (double_Pi * ((pow (logBase, linearVal) - 1.0) / (logBase - 1.0)));
-        else
-            omega.real (double_Pi * linearVal);
-
-        
-        std::complex<double> numerator (0.0, 0.0);
-        std::complex<double> denominator (1.0, 0.0);
-        
-        for (int j = 0; j < Global::numCoeffs * 0.5; ++j)
-        {
-            if (coefficients[j] == 0)
-                continue;
-            numerator += coefficients[j] * exp(-i * omega * std::complex<double>(j));
-            
-        }
-        for (int j = 1; j < Global::numCoeffs * 0.5; ++j)
-        {
-            if (coefficients[j + Global::numCoeffs * 0.5] == 0)
-                continue;
-            denominator -= coefficients[j + Global::numCoeffs * 0.5] * exp(-i * omega * std::complex<double>(j));
-        }
-        data[k-1] = numerator / denominator;
-        highestGain = std::max (abs (data[k-1]), highestGain);
-    }
+    sampler.calculate (coefficients);
+    const std::vector<std::complex<double>>& response = sampler.getResponse();
+    data.assign (response.begin(), response.end());
+    
+    double gain = 0;
+    for (int k = 0; k < data.size(); ++k)
+        gain = std::max (abs (data[k]), gain);
+    highestGain = gain;
     
     linearGainToDB();
 }
@@ -319,7 +336,8 @@ void FreqResponse::linearGainToDB()
     gainAbove0 = false;
     highestDB = -60.0;
     lowestDB = 100.0;
-    for (int i = 0; i < Global::fftOrder; ++i)
+    dBData.resize (data.size());
+    for (int i = 0; i < data.size(); ++i)
     {
         dBData[i] = Global::limit (20.0 * log10(abs(data[i])), -60.0, 1000.0);
         highestDB = std::max (dBData[i], highestDB);
@@ -334,5 +352,6 @@ void FreqResponse::buttonClicked (Button* button)
 {
     logPlot = !logPlot;
     logPlotButton->setButtonText (logPlot ? "Lin. plot" : "Log. plot");
+    sampler.setLogGrid (logPlot, logBase);
     refresh();
 }
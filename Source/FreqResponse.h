@@ -13,7 +13,9 @@
 #include <JuceHeader.h>
 #include "Global.h"
 #include "AppComponent.h"
+#include "AdaptiveSampler.h"
 #include <complex>
+#include <atomic>
 
 //==============================================================================
 /*
@@ -33,9 +35,15 @@ public:
     
     void buttonClicked (Button* button) override;
     
+    // read by the audio thread to scale the output
     double getHighestGain() { return highestGain; };
+
+    void setSampleRate (double sampleRate) override;
+    
+    void setRoots (const std::vector<std::complex<double>>& zeros, const std::vector<std::complex<double>>& poles) override { sampler.setRoots (zeros, poles); };
     
 private:
+    void calculateGridLines();
     
     bool gainAbove0;
     std::vector<double> dBData;
@@ -50,7 +58,7 @@ private:
     
     std::unique_ptr<TextButton> logPlotButton;
 
-    double highestGain = 0;
+    std::atomic<double> highestGain { 0 };
     double highestDB;
     double lowestDB;
     
@@ -59,6 +67,8 @@ private:
     
     std::unique_ptr<Label> dBLabel;
     std::unique_ptr<Label> freqLabel;
+    
+    AdaptiveSampler sampler;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FreqResponse)
 };
@@ -16,7 +16,7 @@ using namespace juce;
 class Global
 {
 public:
-    constexpr static const float initWidth = 1140.0f;
+    constexpr static const float initWidth = 1506.0f;
     constexpr static const float initHeight = 500.0f;
     constexpr static const float initHeightWithOffset = 477.0f;
 
@@ -29,9 +29,55 @@ public:
     constexpr static const float pzAxisMargin = 30.0f;
 
     static const int numCoeffs = 12;
+    constexpr static const double defaultSampleRate = 44100.0; // until the audio device has started
     
     static const int fftOrder = 8192;
+    
+    static const int locusSteps = 2048;
+    constexpr static const double locusRange = 1.0; // the locus coefficient is swept over its value +/- this range
+    
+    static const int heatmapTileSize = 64;
+    static const int heatmapCoarseStep = 8;
+    constexpr static const double heatmapMinDB = -60.0;
+    constexpr static const double heatmapMaxDB = 20.0;
     static const bool showPhaseValue = false;
+    constexpr static const double maxGroupDelay = 1000.0; // in samples, the delay goes to infinity at zeros on the unit circle
+    
+    static const int timeResponseLength = 4096;
+    static const int maxTimeResponseLength = 4194304;
+    static const int timeResponseBins = 1024;
+    static const int timeResponseBlockSize = 4096;
+    constexpr static const double timeResponseDecayDB = -120.0; // the response is stopped once it stays within this distance of its final value
+    constexpr static const double timeResponseBlowUp = 1e12;
+    
+    static const int adaptiveCoarsePoints = 64;
+    static const int adaptiveMaxPoints = 2048;
+    constexpr static const double adaptiveToleranceDB = 0.05; // largest distance between the response and the straight lines between the samples
+    constexpr static const double adaptiveMaxStepDB = 1.0; // intervals where the magnitude changes more than this are split as well
+    constexpr static const double adaptiveMinWidth = 1e-7; // on the 0 - 1 frequency axis
+    constexpr static const double adaptiveFloorDB = -120.0;
+    constexpr static const double adaptiveHintRadius = 0.5; // poles closer to the origin than this do not give a peak
+    constexpr static const double productFormCondition = 1e6; // condition number above which the response is evaluated from the roots
+    static const int rootPolishIterations = 50;
+    static const int audioBlockSize = 512; // the audio callback is processed in chunks of at most this many samples
+    constexpr static const double sweepStartFrequency = 20.0;
+    constexpr static const double sweepEndFrequency = 20000.0;
+    constexpr static const double sweepLength = 5.0; // in seconds
+    constexpr static const double impulsePeriod = 0.5; // in seconds
+    constexpr static const double oscillatorFrequency = 220.0; // of the square and sawtooth waves
+    static const int coefficientRampLength = 1024; // in samples, new coefficients are ramped in over this many samples
+    static const int coefficientRampStep = 32; // the ramped coefficients are updated every this many samples
+    constexpr static const double loadMeterAverageTime = 1.0; // in seconds
+    constexpr static const double loadMeterGapFactor = 1.5; // callbacks that start this many buffer periods after the previous one count as a gap
+    static const int loadMeterRefreshRate = 4; // in Hz
+    static const int filterBankTileSize = 64; // in samples, the filter bank interleaves the channels of a group in tiles of this length
+    static const int filterBankMinChannelsPerThread = 16;
+    static const int parallelIIRMinChunkSize = 4096; // in samples, blocks of files with few channels are split over the threads in chunks of at least this length
+    static const int parallelIIRCheckInterval = 64; // in samples, how often the correction of a chunk checks whether it has died out
+    constexpr static const double parallelIIRCorrectionFloor = 1e-17; // relative to its start, below this the correction is stopped
+    static const int fileReadAheadSize = 32768; // in samples, audio files are read this far ahead of the playback position
+    static const int renderBlockSize = 65536; // files are rendered in blocks of this many samples
+    static const int analysisCacheSize = 64 * 1048576; // in bytes, the results used longest ago are removed above this
 
     constexpr static const float bdCompDim = 40;
     constexpr static const float vertArrowLength = bdCompDim * 0.73;
@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+    GroupDelay.cpp
+    Created: 18 Oct 2026 8:27:33pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "GroupDelay.h"
+
+//==============================================================================
+GroupDelay::GroupDelay (double fs) : AppComponent ("Group Delay", false), fs (fs)
+{
+    delayData.resize (Global::fftOrder);
+
+    calculateGridLines();
+
+    logPlotButton = std::make_unique<TextButton> ();
+    logPlotButton->setButtonText (logPlot ? "Lin. plot" : "Log. plot");
+    logPlotButton->addListener (this);
+    addAndMakeVisible (logPlotButton.get());
+
+    //// Labels ////
+    delayLabel = std::make_unique<Label> ("Delay", "Delay (samples)");
+    delayLabel->setColour(Label::textColourId, Colours::black);
+    delayLabel->setColour(Label::backgroundColourId, Colours::white.withAlpha(0.0f));
+    delayLabel->setJustificationType(Justification::centred);
+    addAndMakeVisible (delayLabel.get());
+
+    freqLabel = std::make_unique<Label> ("Freq", "Freq (Hz)");
+    freqLabel->setColour(Label::textColourId, Colours::black);
+    freqLabel->setColour(Label::backgroundColourId, Colours::white.withAlpha(0.0f));
+    freqLabel->setJustificationType(Justification::centred);
+    addAndMakeVisible (freqLabel.get());
+}
+
+GroupDelay::~GroupDelay()
+{
+}
+
+void GroupDelay::setSampleRate (double sampleRate)
+{
+    fs = sampleRate;
+    calculateGridLines();
+    repaint();
+}
+
+void GroupDelay::calculateGridLines()
+{
+    gridLineCoords.resize (32);
+    int m = 10;
+    int n = 0;
+    for (int i = 1; i <= gridLineCoords.size(); ++i)
+    {
+        ++n;
+        double y = m * n;
+        gridLineCoords[i-1] = log(y * (logBase - 1.0) / (fs * 0.5) + 1.0) / log(logBase);
+        if (n % 10 == 0)
+        {
+            m *= 10;
+            n = 0;
+        }
+    }
+}
+
+void GroupDelay::paint (juce::Graphics& g)
+{
+    drawAppComp (g);
+
+    double plotWidth = getWidth() - (Global::axisMargin + Global::margin);
+    double visualScaling = plotHeight / (highestDelay - lowestDelay);
+
+    //// Draw zero line ////
+    if (lowestDelay < 0)
+    {
+        double zeroHeight = plotYStart + highestDelay * visualScaling;
+        g.drawLine (Global::axisMargin + Global::margin, zeroHeight, getWidth(), zeroHeight, 1.0);
+    }
+
+    //// Draw gridlines ////
+    g.setColour (Colours::lightgrey);
+
+    if (logPlot)
+    {
+        for (int n = 0; n < gridLineCoords.size(); ++n)
+        {
+            g.drawLine (gridLineCoords[n] * plotWidth + Global::axisMargin + Global::margin,
+                        plotYStart,
+                        gridLineCoords[n] * plotWidth + Global::axisMargin + Global::margin,
+                        getHeight() - Global::axisMargin - Global::margin, 1.0f);
+        }
+    } else {
+        int numLines = floor (fs * 0.5 * 0.0005) - 1;
+        double distanceBetweenLines = plotWidth / static_cast<double> (numLines + 1);
+
+        for (int n = 1; n <= numLines; ++n)
+        {
+            g.drawLine (Global::axisMargin + Global::margin + n * distanceBetweenLines,
+                        plotYStart,
+                        Global::axisMargin + Global::margin + n * distanceBetweenLines,
+                        getHeight() - Global::axisMargin - Global::margin, 1.0f);
+        }
+    }
+
+    //// Draw x-axis labels ////
+    g.setFont (equationFont.withHeight (14.0f));
+
+    if (logPlot)
+    {
+        int j = 1;
+        for (int n = 0; n < gridLineCoords.size(); ++n)
+        {
+            g.drawText (String (pow(10, j) * ((n+1) % 10)),
+                        gridLineCoords[n] * plotWidth + Global::axisMargin + Global::margin - 20,
+                        getHeight() - Global::axisMargin - Global::margin,
+                        40, 20, Justification::centred);
+
+            if (n % 10 == 0)
+            {
+                n += 9;
+                ++j;
+            }
+        }
+    } else {
+        int numLines = floor (fs * 0.5 * 0.0005) - 1;
+        double distanceBetweenLines = plotWidth / static_cast<double> (numLines + 1);
+
+        for (int n = 1; n <= numLines; ++n)
+        {
+            g.drawText (String (n * 2000),
+                        Global::axisMargin + Global::margin + n * distanceBetweenLines - 20,
+                        getHeight() - Global::axisMargin - Global::margin,
+                        40, 20, Justification::centred);
+        }
+    }
+
+    //// Plot ////
+    g.setColour (Colours::black);
+    g.strokePath (generateResponsePath(), PathStrokeType(2.0f));
+
+    //// Draw axes ////
+    g.drawLine (Global::margin + Global::axisMargin,
+                plotYStart,
+                Global::margin + Global::axisMargin,
+                getHeight() - Global::axisMargin - Global::margin);
+
+    g.drawLine (Global::margin + Global::axisMargin,
+                getHeight() - Global::axisMargin - Global::margin,
+                getWidth(),
+                getHeight() - Global::axisMargin - Global::margin);
+
+    //// Draw y-axis labels ////
+    g.drawText (String (round (highestDelay * 10) / 10.0),
+                0.0f,
+                plotYStart - equationFont.getHeight() * 0.5,
+                Global::axisMargin + Global::margin * 0.5,
+                equationFont.getHeight(), Justification::centredRight, false);
+
+    g.drawText (String (round (lowestDelay * 10) / 10.0),
+                0.0f,
+                plotYStart + plotHeight - equationFont.getHeight() * 0.5,
+                Global::axisMargin + Global::margin * 0.5,
+                equationFont.getHeight(), Justification::centredRight, false);
+}
+
+void GroupDelay::resized()
+{
+    logPlotButton->setBounds (getWidth() - 100 - Global::margin, Global::margin, 100, 25);
+    plotHeight = (getHeight() - Global::axisMargin - Global::margin - plotYStart);
+
+    float labelWidth = delayLabel->getFont().getStringWidth (delayLabel->getText());
+    delayLabel->setBounds (-labelWidth * 0.5, plotYStart + 0.5 * plotHeight - delayLabel->getFont().getHeight() * 0.5, plotHeight, delayLabel->getFont().getHeight());
+
+    AffineTransform transformDelay;
+    transformDelay = transformDelay.rotated (-0.5 * double_Pi, delayLabel->getX() + delayLabel->getWidth() * 0.5, delayLabel->getY() + delayLabel->getHeight() * 0.5);
+    transformDelay = transformDelay.translated (-Global::axisMargin * 0.25, 0);
+    delayLabel->setTransform (transformDelay);
+    freqLabel->setBounds (Global::axisMargin, plotYStart + plotHeight + Global::axisMargin * 0.6, getWidth() - Global::axisMargin, Global::axisMargin * 0.5);
+}
+
+Path GroupDelay::generateResponsePath()
+{
+    Path response;
+    double visualScaling = plotHeight / (highestDelay - lowestDelay);
+
+    auto spacing = (getWidth() - Global::margin - Global::axisMargin) / static_cast<double> (delayData.size());
+    double x = Global::margin + Global::axisMargin;
+    bool startNewSubPath = true;
+    for (int i = 0; i < delayData.size(); ++i)
+    {
+        // zeros on the unit circle give an infinite delay; leave a gap there
+        if (std::isfinite (delayData[i]))
+        {
+            float y = plotYStart + (highestDelay - Global::limit (delayData[i], lowestDelay, highestDelay)) * visualScaling;
+            if (startNewSubPath)
+                response.startNewSubPath (x, y);
+            else
+                response.lineTo (x, y);
+            startNewSubPath = false;
+        }
+        else
+        {
+            startNewSubPath = true;
+        }
+        x += spacing;
+    }
+
+    return response;
+}
+
+void GroupDelay::calculate()
+{
+    // the group delay comes out of the same pass as the frequency response
+    responseEngine->setLogGrid (logPlot, logBase);
+    responseEngine->calculate (coefficients);
+    const std::vector<double>& groupDelay = responseEngine->getGroupDelay();
+    data = responseEngine->getResponse();
+
+    highestDelay = 0;
+    lowestDelay = 0;
+    for (int k = 0; k < Global::fftOrder; ++k)
+    {
+        delayData[k] = groupDelay[k];
+        if (!std::isfinite (delayData[k]))
+            continue;
+        highestDelay = std::max (Global::limit (delayData[k], -Global::maxGroupDelay, Global::maxGroupDelay), highestDelay);
+        lowestDelay = std::min (Global::limit (delayData[k], -Global::maxGroupDelay, Global::maxGroupDelay), lowestDelay);
+    }
+
+    // keep a range of at least one sample so a constant delay can still be scaled
+    if (highestDelay - lowestDelay < 1.0)
+        highestDelay = lowestDelay + 1.0;
+}
+
+void GroupDelay::buttonClicked (Button* button)
+{
+    logPlot = !logPlot;
+    logPlotButton->setButtonText (logPlot ? "Lin. plot" : "Log. plot");
+    refresh();
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    GroupDelay.h
+    Created: 18 Oct 2026 8:27:33pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include "AppComponent.h"
+#include "ResponseEngine.h"
+
+//==============================================================================
+/*
+*/
+class GroupDelay  : public AppComponent, public Button::Listener
+{
+public:
+    GroupDelay (double fs);
+    ~GroupDelay() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    void calculate() override;
+    void setRoots (const std::vector<std::complex<double>>& zeros, const std::vector<std::complex<double>>& poles) override { responseEngine->setRoots (zeros, poles); };
+    Path generateResponsePath();
+
+    void buttonClicked (Button* button) override;
+
+    void setSampleRate (double sampleRate) override;
+
+private:
+    void calculateGridLines();
+
+    std::vector<double> delayData;
+    std::vector<double> gridLineCoords;
+
+    bool logPlot = false;
+    double logBase = 1000;
+    double fs;
+
+    double plotYStart = 40 + Global::margin;
+    double plotHeight = 1;
+
+    double highestDelay = 1;
+    double lowestDelay = 0;
+
+    std::unique_ptr<TextButton> logPlotButton;
+
+    std::unique_ptr<Label> delayLabel;
+    std::unique_ptr<Label> freqLabel;
+
+    SharedResourcePointer<ResponseEngine> responseEngine; // shared by the phase response and the group delay
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GroupDelay)
+};
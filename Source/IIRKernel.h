@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    IIRKernel.h
+    Created: 18 Oct 2026 9:03:09pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+
+using namespace juce;
+//==============================================================================
+/*
+    The difference equation
+        y[n] = b0 x[n] + ... + bNB x[n-NB] + a1 y[n-1] + ... + aNA y[n-NA]
+    with the orders as template arguments. The sums are unrolled at compile
+    time, so zero coefficients at the end cost nothing and the state stays in
+    registers.
+
+    The kernels always keep maxOrder past inputs and outputs, not only the ones
+    they use, so the filter can switch to a kernel of a different order between
+    two blocks without losing its history.
+*/
+namespace IIRKernelHelpers
+{
+    // c[First] s[First] + ... + c[Last] s[Last]
+    template <int First, int Last, int numTerms = Last - First + 1>
+    struct DotProduct
+    {
+        static forcedinline double calculate (const double* c, const double* s) noexcept
+        {
+            return c[First] * s[First] + DotProduct<First + 1, Last>::calculate (c, s);
+        }
+    };
+
+    template <int First, int Last>
+    struct DotProduct<First, Last, 1>
+    {
+        static forcedinline double calculate (const double* c, const double* s) noexcept { return c[First] * s[First]; }
+    };
+
+    template <int First, int Last>
+    struct DotProduct<First, Last, 0>
+    {
+        static forcedinline double calculate (const double*, const double*) noexcept { return 0.0; }
+    };
+
+    // s[K] = s[K - 1] for K = Last ... 1
+    template <int Last>
+    struct Shift
+    {
+        static forcedinline void apply (double* s) noexcept
+        {
+            s[Last] = s[Last - 1];
+            Shift<Last - 1>::apply (s);
+        }
+    };
+
+    template <>
+    struct Shift<0>
+    {
+        static forcedinline void apply (double*) noexcept {}
+    };
+}
+
+template <int NB, int NA>
+struct IIRKernel
+{
+    static const int maxOrder = Global::numCoeffs / 2 - 1;
+    static_assert (NB >= 0 && NB <= maxOrder && NA >= 0 && NA <= maxOrder, "the orders have to fit in the coefficients");
+
+    // b and a as in FilterEngine (a[0] is not used), the states are x[n-1] ... x[n-maxOrder] and y[n-1] ... y[n-maxOrder]
+    template <typename SampleType>
+    static void process (const double* b, const double* a, double* xState, double* yState,
+                         const SampleType* input, SampleType* output, int numSamples)
+    {
+        using namespace IIRKernelHelpers;
+
+        double bLocal[NB + 1];
+        double aLocal[NA + 1];
+        for (int k = 0; k <= NB; ++k)
+            bLocal[k] = b[k];
+        for (int k = 1; k <= NA; ++k)
+            aLocal[k] = a[k];
+
+        // x[0] is the current input, y[0] is not used
+        double x[maxOrder + 1];
+        double y[maxOrder + 1];
+        for (int k = 1; k <= maxOrder; ++k)
+        {
+            x[k] = xState[k - 1];
+            y[k] = yState[k - 1];
+        }
+        y[0] = 0.0;
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            x[0] = static_cast<double> (input[n]);
+            double y0 = DotProduct<0, NB>::calculate (bLocal, x);
+            if (NA > 0)
+                y0 += DotProduct<1, NA>::calculate (aLocal, y);
+
+            Shift<maxOrder>::apply (x);
+            Shift<maxOrder>::apply (y);
+            y[1] = y0;
+
+            output[n] = static_cast<SampleType> (y0);
+        }
+
+        for (int k = 1; k <= maxOrder; ++k)
+        {
+            xState[k - 1] = x[k];
+            yState[k - 1] = y[k];
+        }
+    }
+};
+
+//==============================================================================
+// All kernels for one sample type, indexed by the orders.
+template <typename SampleType>
+class IIRKernelTable
+{
+public:
+    static const int maxOrder = Global::numCoeffs / 2 - 1;
+
+    typedef void (*Kernel) (const double* b, const double* a, double* xState, double* yState,
+                            const SampleType* input, SampleType* output, int numSamples);
+
+    static Kernel get (int numeratorOrder, int denominatorOrder)
+    {
+        static const IIRKernelTable table;
+        return table.kernels[numeratorOrder][denominatorOrder];
+    }
+
+private:
+    IIRKernelTable() { Filler<0>::fill (kernels); }
+
+    template <int Idx, bool done = (Idx > maxOrder * (maxOrder + 2))>
+    struct Filler
+    {
+        static void fill (Kernel (&kernels)[maxOrder + 1][maxOrder + 1])
+        {
+            const int NB = Idx / (maxOrder + 1);
+            const int NA = Idx % (maxOrder + 1);
+            kernels[NB][NA] = &IIRKernel<NB, NA>::template process<SampleType>;
+            Filler<Idx + 1>::fill (kernels);
+        }
+    };
+
+    template <int Idx>
+    struct Filler<Idx, true>
+    {
+        static void fill (Kernel (&)[maxOrder + 1][maxOrder + 1]) {}
+    };
+
+    Kernel kernels[maxOrder + 1][maxOrder + 1];
+};
@@ -7,45 +7,96 @@ MainComponent::MainComponent()
     addAndMakeVisible (coefficientList);
 
     for (int i = 0; i < Global::numCoeffs; ++i)
+    {
         coefficientList.getTextEditor (i).addListener(this);
+        coefficientList.getTextEditor (i).addKeyListener (this);
+    }
+    coefficientList.addMouseListener (this, true);
+    
+    // the values the list starts with are not an edit, so there is nothing to undo yet
+    filterModel.reset (coefficientList.getCoefficients());
+    filterModel.addListener (this);
     
-    appComponents.resize (7);
+    appComponents.resize (9);
     appComponents[0] = std::make_shared<DifferenceEq> ();
     differenceEq = std::static_pointer_cast<DifferenceEq>(appComponents[0]);
     appComponents[1] = std::make_shared<TransferFunction> ();
     transferFunction = std::static_pointer_cast<TransferFunction>(appComponents[1]);
     appComponents[2] = std::make_shared<PoleZeroPlot> ();
     poleZeroPlot = std::static_pointer_cast<PoleZeroPlot>(appComponents[2]);
+    poleZeroPlot->addChangeListener (this);
+    poleZeroPlot->addMouseListener (this, true);
     appComponents[3] = std::make_shared<BlockDiagram> ();
     blockDiagram = std::static_pointer_cast<BlockDiagram>(appComponents[3]);
     appComponents[4] = std::make_shared<AudioPlayer> ();
     audioPlayer = std::static_pointer_cast<AudioPlayer>(appComponents[4]);
 
+    // the analysis components start at the default sample rate and are told the real one once the device has started.
+    // make_shared takes its arguments by reference, which would odr-use the constant, so a copy is passed.
+    double fs = Global::defaultSampleRate;
+    appComponents[5] = std::make_shared<FreqResponse> (fs);
+    freqResponse = std::static_pointer_cast<FreqResponse>(appComponents[5]);
+    appComponents[6] = std::make_shared<PhaseResponse> (fs);
+    phaseResponse = std::static_pointer_cast<PhaseResponse>(appComponents[6]);
+    appComponents[7] = std::make_shared<GroupDelay> (fs);
+    groupDelay = std::static_pointer_cast<GroupDelay>(appComponents[7]);
+    appComponents[8] = std::make_shared<TimeResponse> (fs);
+    timeResponse = std::static_pointer_cast<TimeResponse>(appComponents[8]);
 
-    for (int i = 0; i < 5; ++i)
-    {
-        appComponents[i]->setCoefficients (coefficientList.getCoefficients());
-        appComponents[i]->refresh();
-        addAndMakeVisible (appComponents[i].get());
+    refreshComponents (filterModel.getSnapshot(), FilterModel::allCoefficientsMask);
+    for (auto comp : appComponents)
+        addAndMakeVisible (comp.get());
 
-    }
+    setSize (Global::initWidth, Global::initHeight);
 
     // Some platforms require permissions to open input channels so request that here
     if (juce::RuntimePermissions::isRequired (juce::RuntimePermissions::recordAudio)
         && ! juce::RuntimePermissions::isGranted (juce::RuntimePermissions::recordAudio))
     {
         juce::RuntimePermissions::request (juce::RuntimePermissions::recordAudio,
-                                           [&] (bool granted) { setAudioChannels (granted ? 2 : 0, 2); });
+                                           [&] (bool granted) { openAudioDevice (granted); });
     }
     else
     {
-        // Specify the number of input and output channels that we want to open
-        setAudioChannels (0, 2);
+        openAudioDevice (true);
     }
 }
 
+void MainComponent::openAudioDevice (bool inputAllowed)
+{
+    setAudioChannels (inputAllowed ? 2 : 0, 2);
+
+    // the live input is filtered on every channel the device has, with one filter engine per channel
+    auto* device = deviceManager.getCurrentAudioDevice();
+    if (device == nullptr)
+        return;
+
+    // the device can be replaced when it is opened again
+    String deviceName = device->getName();
+    AudioDeviceManager::AudioDeviceSetup setup;
+    deviceManager.getAudioDeviceSetup (setup);
+    setup.useDefaultInputChannels = false;
+    setup.useDefaultOutputChannels = false;
+    setup.inputChannels.clear();
+    if (inputAllowed)
+        setup.inputChannels.setRange (0, device->getInputChannelNames().size(), true);
+    setup.outputChannels.clear();
+    setup.outputChannels.setRange (0, device->getOutputChannelNames().size(), true);
+
+    String error = deviceManager.setAudioDeviceSetup (setup, true);
+    if (error.isNotEmpty())
+        Logger::writeToLog ("Could not open all channels of " + deviceName + ": " + error);
+}
+
 MainComponent::~MainComponent()
 {
+    poleZeroPlot->removeChangeListener (this);
+    poleZeroPlot->removeMouseListener (this);
+    coefficientList.removeMouseListener (this);
+    for (int i = 0; i < Global::numCoeffs; ++i)
+        coefficientList.getTextEditor (i).removeKeyListener (this);
+    filterModel.removeListener (this);
+    
     // This shuts down the audio device and clears the audio source.
     shutdownAudio();
 }
@@ -60,20 +111,21 @@ void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRat
     // but be careful - it will be called on the audio thread, not the GUI thread.
 
     // For more details, see the help for AudioProcessor::prepareToPlay()
-    int idx = appComponents.size() - 2;
-    appComponents[idx] = std::make_shared<FreqResponse> (sampleRate);
-    freqResponse = std::static_pointer_cast<FreqResponse>(appComponents[idx]);
-    appComponents[idx]->setCoefficients (coefficientList.getCoefficients());
-    appComponents[idx]->refresh();
-    addAndMakeVisible (appComponents[idx].get());
-
-    appComponents[idx+1] = std::make_shared<PhaseResponse> (sampleRate);
-    phaseResponse = std::static_pointer_cast<PhaseResponse>(appComponents[idx+1]);
-    appComponents[idx+1]->setCoefficients (coefficientList.getCoefficients());
-    appComponents[idx+1]->refresh();
-    addAndMakeVisible (appComponents[idx+1].get());
+    auto* device = deviceManager.getCurrentAudioDevice();
+    int numChannels = device == nullptr ? 2 : jmax (device->getActiveInputChannels().countNumberOfSetBits(),
+                                                    device->getActiveOutputChannels().countNumberOfSetBits());
+    audioPlayer->prepareToPlay (sampleRate, numChannels, samplesPerBlockExpected);
 
-    setSize (Global::initWidth, Global::initHeight);
+    // the components are only told about the new sample rate on the message thread
+    deviceSampleRate = sampleRate;
+    triggerAsyncUpdate();
+}
+
+void MainComponent::handleAsyncUpdate()
+{
+    double sampleRate = deviceSampleRate;
+    for (auto comp : appComponents)
+        comp->setSampleRate (sampleRate);
 }
 
 void MainComponent::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
@@ -81,30 +133,23 @@ void MainComponent::getNextAudioBlock (const juce::AudioSourceChannelInfo& buffe
     // Your audio-processing code goes here!
 
     // For more details, see the help for AudioProcessor::getNextAudioBlock()
+    AudioLoadMeter::ScopedMeasurement measurement (audioPlayer->getLoadMeter(), bufferToFill.numSamples);
 
-    // Right now we are not producing any data, in which case we need to clear the buffer
-    // (to prevent the output of random noise)
-    bufferToFill.clearActiveBufferRegion();
-    float* const channeldataL = bufferToFill.buffer->getWritePointer (0);
-    float* const channeldataR = bufferToFill.buffer->getWritePointer (1);
-    
-    if (poleZeroPlot->isStable())
+    // an unstable filter would blow up, so it is kept silent until it is stable again
+    if (! poleZeroPlot->isStable())
         audioPlayer->resetStates();
     
-    if (poleZeroPlot->isStable() && audioPlayer->shouldPlayNoise())
+    if (poleZeroPlot->isStable() && audioPlayer->shouldPlay())
         play = true;
     else
         play = false;
     
-    outputScaling = audioPlayer->shouldScaleOutput() ? 1.0 / freqResponse->getHighestGain() : 1.0;
-    for (int i = 0; i < bufferToFill.buffer->getNumSamples(); ++i)
-    {
-        audioPlayer->calculate();
-        channeldataL[i] = Global::outputLimit (play ? audioPlayer->getOutput() * outputScaling * 0.5 : 0.0);
-        if (channeldataR != nullptr)
-            channeldataR[i] = Global::outputLimit (play ? audioPlayer->getOutput() * outputScaling * 0.5 : 0.0);
-    }
-   
+    double highestGain = freqResponse->getHighestGain();
+    outputScaling = audioPlayer->shouldScaleOutput() && highestGain > 0 ? 1.0 / highestGain : 1.0;
+    
+    // the filter keeps running while it is not played. The buffer holds the device input, which
+    // the audio player either filters in place or overwrites with a test signal.
+    audioPlayer->processBlock (*bufferToFill.buffer, bufferToFill.startSample, bufferToFill.numSamples, play ? outputScaling : 0.0f);
 }
 
 void MainComponent::releaseResources()
@@ -113,6 +158,7 @@ void MainComponent::releaseResources()
     // restarted due to a setting change.
 
     // For more details, see the help for AudioProcessor::releaseResources()
+    audioPlayer->releaseResources();
 }
 
 //==============================================================================
@@ -160,9 +206,10 @@ void MainComponent::resized()
     Rectangle<int> leftPart = totArea.removeFromLeft (366);
     Rectangle<int> middlePart = totArea.removeFromLeft (300);
     Rectangle<int> rightPart = totArea.removeFromLeft (324);
+    Rectangle<int> analysisPart = totArea.removeFromLeft (366);
     
-    audioPlayer->setBounds (leftPart.removeFromTop (50));
-    freqResponse->setBounds (leftPart.removeFromTop ((Global::initHeightWithOffset - 50) * 0.5));
+    audioPlayer->setBounds (leftPart.removeFromTop (80));
+    freqResponse->setBounds (leftPart.removeFromTop ((Global::initHeightWithOffset - 80) * 0.5));
     phaseResponse->setBounds (leftPart);
     
     poleZeroPlot->setBounds (middlePart.removeFromBottom (300));
@@ -170,6 +217,9 @@ void MainComponent::resized()
     transferFunction->setBounds (middlePart);
 
     blockDiagram->setBounds (rightPart.withHeight (rightPart.getHeight() * 2.0));
+    
+    groupDelay->setBounds (analysisPart.removeFromTop (Global::initHeightWithOffset * 0.5));
+    timeResponse->setBounds (analysisPart);
     for (auto comp : appComponents)
         if (comp->getTitle() != "Block Diagram") // updated in the paint function
             comp->setTransform (transform);
@@ -185,11 +235,110 @@ void MainComponent::textEditorTextChanged (TextEditor& textEditor)
     bool isACoeff = textEditor.getName().startsWith("a");
     int idx = textEditor.getName().removeCharacters (isACoeff ? "a" : "b").getIntValue() + (isACoeff ? Global::numCoeffs * 0.5 : 0);
     
+    // a drag changes the text as well, but then the mouse gesture is already running
+    if (!mouseGesture && &textEditor != typingEditor)
+    {
+        filterModel.beginGesture();
+        typingEditor = &textEditor;
+    }
+    
     coefficientList.updateCoeff (idx);
+    filterModel.setCoefficient (idx, coefficientList.getCoefficients()[idx]);
+}
+
+void MainComponent::textEditorReturnKeyPressed (TextEditor& textEditor)
+{
+    if (&textEditor == typingEditor)
+    {
+        filterModel.endGesture();
+        typingEditor = nullptr;
+    }
+}
+
+void MainComponent::textEditorFocusLost (TextEditor& textEditor)
+{
+    textEditorReturnKeyPressed (textEditor);
+}
+
+void MainComponent::mouseDown (const MouseEvent& e)
+{
+    typingEditor = nullptr;
+    mouseGesture = true;
+    filterModel.beginGesture();
+}
+
+void MainComponent::mouseUp (const MouseEvent& e)
+{
+    // the last move of a dragged root may still be waiting in the message queue
+    poleZeroPlot->dispatchPendingMessages();
+    mouseGesture = false;
+    filterModel.endGesture();
+}
+
+bool MainComponent::keyPressed (const KeyPress& key)
+{
+    if (key == KeyPress ('z', ModifierKeys::commandModifier, 0))
+    {
+        undo();
+        return true;
+    }
+    
+    if (key == KeyPress ('z', ModifierKeys::commandModifier | ModifierKeys::shiftModifier, 0)
+        || key == KeyPress ('y', ModifierKeys::commandModifier, 0))
+    {
+        redo();
+        return true;
+    }
+    return false;
+}
+
+bool MainComponent::keyPressed (const KeyPress& key, Component* originatingComponent)
+{
+    return keyPressed (key);
+}
+
+void MainComponent::undo()
+{
+    typingEditor = nullptr;
+    
+    // the coefficient list is only updated here, updating it on every edit would reformat the text that is being typed
+    if (filterModel.undo())
+        coefficientList.setCoefficients (filterModel.getSnapshot());
+}
+
+void MainComponent::redo()
+{
+    typingEditor = nullptr;
+    if (filterModel.redo())
+        coefficientList.setCoefficients (filterModel.getSnapshot());
+}
+
+void MainComponent::changeListenerCallback (ChangeBroadcaster* source)
+{
+    // a pole or zero has been dragged
+    if (source == poleZeroPlot.get())
+    {
+        coefficientList.setCoefficients (poleZeroPlot->getCoefficients());
+        filterModel.setCoefficients (coefficientList.getCoefficients());
+    }
+}
+
+void MainComponent::filterModelChanged (const FilterModel::Snapshot& snapshot, uint32 changeMask)
+{
+    refreshComponents (snapshot, changeMask);
+}
+
+void MainComponent::refreshComponents (const FilterModel::Snapshot& snapshot, uint32 changeMask)
+{
     for (auto comp : appComponents)
     {
-        comp->setCoefficients (coefficientList.getCoefficients());
-        if (comp->getTitle() != "Audio")
+        comp->setCoefficients (snapshot, changeMask);
+        
+        // the pole-zero plot comes before the response plots, so its roots are up to date here
+        if (comp != poleZeroPlot)
+            comp->setRoots (poleZeroPlot->getZeros(), poleZeroPlot->getPoles());
+        
+        if (comp->needsRefresh (changeMask))
             comp->refresh();
     }
 }
@@ -7,16 +7,23 @@
 #include "TransferFunction.h"
 #include "FreqResponse.h"
 #include "PhaseResponse.h"
+#include "GroupDelay.h"
+#include "TimeResponse.h"
 #include "PoleZeroPlot.h"
 #include "BlockDiagram.h"
 #include "AudioPlayer.h"
+#include "FilterModel.h"
 //==============================================================================
 /*
     This component lives inside our window, and this is where you should put all
     your controls and content.
 */
 class MainComponent  : public juce::AudioAppComponent,
-                       public TextEditor::Listener
+                       public TextEditor::Listener,
+                       public ChangeListener,
+                       public FilterModel::Listener,
+                       public KeyListener,
+                       public AsyncUpdater
 {
 public:
     //==============================================================================
@@ -28,16 +35,41 @@ public:
     void getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill) override;
     void releaseResources() override;
 
+    // passes a new sample rate of the device on to the components
+    void handleAsyncUpdate() override;
+
     //==============================================================================
     void paint (juce::Graphics& g) override;
     void resized() override;
 
     void textEditorTextChanged (TextEditor& textEditor) override;
+    void textEditorReturnKeyPressed (TextEditor& textEditor) override;
+    void textEditorFocusLost (TextEditor& textEditor) override;
+    void changeListenerCallback (ChangeBroadcaster* source) override;
+    void filterModelChanged (const FilterModel::Snapshot& snapshot, uint32 changeMask) override;
+    
+    // every drag of a coefficient or a root is one undo step
+    void mouseDown (const MouseEvent& e) override;
+    void mouseUp (const MouseEvent& e) override;
+    
+    // cmd+z to undo, cmd+shift+z or cmd+y to redo. The text editors would use cmd+z for their own
+    // undo, so this listens to their keys as well.
+    bool keyPressed (const KeyPress& key) override;
+    bool keyPressed (const KeyPress& key, Component* originatingComponent) override;
     
 private:
+    // opens the default device with all of its output channels, and all of its input channels if input is allowed
+    void openAudioDevice (bool inputAllowed);
+
+    void undo();
+    void redo();
+
+    void refreshComponents (const FilterModel::Snapshot& snapshot, uint32 changeMask);
+    
     //==============================================================================
     // Your private member variables go here...
     Coefficientlist coefficientList;
+    FilterModel filterModel;
 
     std::vector<std::shared_ptr<AppComponent>> appComponents;
     
@@ -45,10 +77,17 @@ private:
     std::shared_ptr<TransferFunction> transferFunction;
     std::shared_ptr<FreqResponse> freqResponse;
     std::shared_ptr<PhaseResponse> phaseResponse;
+    std::shared_ptr<GroupDelay> groupDelay;
+    std::shared_ptr<TimeResponse> timeResponse;
     std::shared_ptr<PoleZeroPlot> poleZeroPlot;
     std::shared_ptr<BlockDiagram> blockDiagram;
     std::shared_ptr<AudioPlayer> audioPlayer;
 
+    bool mouseGesture = false;
+    TextEditor* typingEditor = nullptr; // all typing in the same editor is one undo step
+    
+    std::atomic<double> deviceSampleRate { Global::defaultSampleRate };
+
     bool play = false;
     float outputScaling = 1.0;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    NoiseGenerator.cpp
+    Created: 18 Oct 2026 8:46:52pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "NoiseGenerator.h"
+
+//==============================================================================
+NoiseGenerator::NoiseGenerator()
+{
+    setSeed (static_cast<uint64> (Random::getSystemRandom().nextInt64()));
+}
+
+NoiseGenerator::NoiseGenerator (uint64 seed)
+{
+    setSeed (seed);
+}
+
+void NoiseGenerator::setSeed (uint64 seed)
+{
+    // splitmix64 spreads the seed over the state, which cannot end up all zero this way
+    auto splitMix = [&seed] () {
+        uint64 z = (seed += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    };
+
+    s0 = splitMix();
+    s1 = splitMix();
+    s2 = splitMix();
+    s3 = splitMix();
+}
+
+void NoiseGenerator::fillUniform (double* output, int numSamples, double min, double max)
+{
+    // the upper 53 bits of xoshiro256+ as a double in [0, 1), scaled to [min, max)
+    const double scaling = (max - min) / 9007199254740992.0;
+
+    // local copies, so the state is not written back to memory after every sample
+    uint64 a = s0, b = s1, c = s2, d = s3;
+    for (int n = 0; n < numSamples; ++n)
+    {
+        output[n] = min + static_cast<double> ((a + d) >> 11) * scaling;
+
+        uint64 t = b << 17;
+        c ^= a;
+        d ^= b;
+        b ^= c;
+        a ^= d;
+        c ^= t;
+        d = (d << 45) | (d >> 19);
+    }
+    s0 = a;
+    s1 = b;
+    s2 = c;
+    s3 = d;
+}
+
+void NoiseGenerator::fillGaussian (double* output, int numSamples, double mean, double standardDeviation)
+{
+    // uniform values first, then every pair is turned into two normally distributed ones
+    fillUniform (output, numSamples, 0.0, 1.0);
+
+    for (int n = 0; n + 1 < numSamples; n += 2)
+    {
+        double radius = standardDeviation * sqrt (-2.0 * log (1.0 - output[n])); // 1 - u is never 0
+        double angle = 2.0 * double_Pi * output[n + 1];
+        output[n] = mean + radius * cos (angle);
+        output[n + 1] = mean + radius * sin (angle);
+    }
+
+    if (numSamples % 2 == 1)
+    {
+        double extra;
+        fillUniform (&extra, 1, 0.0, 1.0);
+        output[numSamples - 1] = mean + standardDeviation * sqrt (-2.0 * log (1.0 - output[numSamples - 1])) * cos (2.0 * double_Pi * extra);
+    }
+}
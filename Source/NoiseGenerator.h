@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    NoiseGenerator.h
+    Created: 18 Oct 2026 8:46:52pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+
+using namespace juce;
+//==============================================================================
+/*
+    White noise in blocks from a xoshiro256+ generator. fillUniform() keeps the
+    state in registers for the whole block, which is faster than running
+    several generators side by side: their lane loop is not vectorised (there
+    is no SSE2 conversion from 64 bit integers to doubles), and even written
+    with intrinsics it is hardly faster.
+
+    The same seed always gives the same noise, so results can be reproduced.
+*/
+class NoiseGenerator
+{
+public:
+    // seeded from the system random generator
+    NoiseGenerator();
+    NoiseGenerator (uint64 seed);
+
+    void setSeed (uint64 seed);
+
+    // uniformly distributed between min and max
+    void fillUniform (double* output, int numSamples, double min = -1.0, double max = 1.0);
+
+    // normally distributed (Box-Muller)
+    void fillGaussian (double* output, int numSamples, double mean = 0.0, double standardDeviation = 1.0);
+
+private:
+    uint64 s0, s1, s2, s3;
+};
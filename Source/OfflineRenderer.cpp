@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 18 Oct 2026 8:52:59pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+
+//==============================================================================
+class OfflineRenderer::RenderJob : public ThreadPoolJob
+{
+public:
+    RenderJob (OfflineRenderer& owner, const File& input, const std::vector<double>& coefficients, int numThreads)
+        : ThreadPoolJob ("Render " + input.getFileName()), owner (owner), input (input), coefficients (coefficients), numThreads (numThreads)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        File output = input.getSiblingFile (input.getFileNameWithoutExtension() + "_filtered.wav").getNonexistentSibling();
+        if (! renderFile (output))
+            output.deleteFile();
+
+        --owner.numFilesLeft;
+        owner.sendChangeMessage();
+        return jobHasFinished;
+    }
+
+private:
+    bool renderFile (const File& output)
+    {
+        std::unique_ptr<AudioFormatReader> reader (owner.formatManager.createReaderFor (input));
+        if (reader == nullptr)
+        {
+            Logger::writeToLog ("Could not read " + input.getFullPathName());
+            return false;
+        }
+
+        const int numChannels = static_cast<int> (reader->numChannels);
+        std::unique_ptr<FileOutputStream> stream (output.createOutputStream());
+        if (stream == nullptr)
+        {
+            Logger::writeToLog ("Could not write " + output.getFullPathName());
+            return false;
+        }
+
+        WavAudioFormat wavFormat;
+        std::unique_ptr<AudioFormatWriter> writer (wavFormat.createWriterFor (stream.get(), reader->sampleRate,
+                                                                              static_cast<unsigned int> (numChannels), 32, {}, 0));
+        if (writer == nullptr)
+            return false;
+        stream.release(); // the writer owns it now
+
+        // the filter bank only uses more threads for many channels, otherwise the blocks are split in time
+        std::unique_ptr<FilterBank> filterBank;
+        std::unique_ptr<ParallelIIR> parallelIIR;
+        if (numThreads > 1 && numChannels < 2 * Global::filterBankMinChannelsPerThread)
+        {
+            parallelIIR = std::make_unique<ParallelIIR> (numChannels, numThreads);
+            parallelIIR->setCoefficients (coefficients);
+        }
+        else
+        {
+            filterBank = std::make_unique<FilterBank> (numChannels, numThreads);
+            filterBank->setCoefficients (coefficients);
+        }
+
+        AudioBuffer<float> buffer (numChannels, Global::renderBlockSize);
+        for (int64 pos = 0; pos < reader->lengthInSamples; pos += Global::renderBlockSize)
+        {
+            if (shouldExit())
+                return false;
+
+            int numSamples = static_cast<int> (jmin (static_cast<int64> (Global::renderBlockSize), reader->lengthInSamples - pos));
+            reader->read (&buffer, 0, numSamples, pos, true, true);
+
+            if (parallelIIR != nullptr)
+                parallelIIR->process (buffer.getArrayOfWritePointers(), numSamples);
+            else
+                filterBank->process (buffer.getArrayOfWritePointers(), numSamples);
+
+            if (! writer->writeFromAudioSampleBuffer (buffer, 0, numSamples))
+                return false;
+        }
+
+        Logger::writeToLog ("Rendered " + output.getFullPathName() + ", filtered at "
+                            + String ((parallelIIR != nullptr ? parallelIIR->getChannelSamplesPerSecond()
+                                                              : filterBank->getChannelSamplesPerSecond()) / 1e6, 1) + "M channel-samples per second");
+        return true;
+    }
+
+    OfflineRenderer& owner;
+    File input;
+    std::vector<double> coefficients;
+    int numThreads;
+};
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer()
+{
+    formatManager.registerBasicFormats();
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+    stop();
+}
+
+void OfflineRenderer::render (const Array<File>& files, const std::vector<double>& coefficients)
+{
+    // a single file can use all cores for its channels, otherwise every file has one
+    int numThreads = files.size() == 1 ? SystemStats::getNumCpus() : 1;
+    for (auto& file : files)
+    {
+        ++numFilesLeft;
+        threadPool.addJob (new RenderJob (*this, file, coefficients, numThreads), true);
+    }
+}
+
+void OfflineRenderer::stop()
+{
+    threadPool.removeAllJobs (true, 10000);
+    numFilesLeft = 0;
+}
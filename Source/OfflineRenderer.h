@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 18 Oct 2026 8:52:59pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include "FilterBank.h"
+#include "ParallelIIR.h"
+#include <atomic>
+
+//==============================================================================
+/*
+    Filters whole audio files as fast as possible and writes the results next
+    to them as 32 bit float WAV files (so nothing clips), called
+    <name>_filtered.wav. Every file is a job on a thread pool, so several files
+    are rendered at the same time. The channels of a single file are split
+    over the cores by its FilterBank, or, if it has too few channels for that,
+    its blocks are split in time by a ParallelIIR. A change message is sent
+    whenever a file is done.
+*/
+class OfflineRenderer : public ChangeBroadcaster
+{
+public:
+    OfflineRenderer();
+    ~OfflineRenderer() override;
+
+    void render (const Array<File>& files, const std::vector<double>& coefficients);
+
+    // cancel all files that are not done yet, the ones that were started are removed
+    void stop();
+
+    int getNumFilesLeft() const { return numFilesLeft; };
+
+    AudioFormatManager& getFormatManager() { return formatManager; };
+
+private:
+    class RenderJob;
+
+    AudioFormatManager formatManager;
+    std::atomic<int> numFilesLeft { 0 };
+
+    ThreadPool threadPool { jmax (1, SystemStats::getNumCpus() - 1) };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineRenderer)
+};
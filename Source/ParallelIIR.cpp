@@ -0,0 +1,267 @@
+/*
+  ==============================================================================
+
+    ParallelIIR.cpp
+    Created: 18 Oct 2026 9:06:05pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ParallelIIR.h"
+
+static_assert (ParallelIIR::order == 5, "the correction in correctChunk() is written out for a fifth order filter");
+
+//==============================================================================
+// Runs one pass on one chunk.
+class ParallelIIR::Worker : public ThreadPoolJob
+{
+public:
+    Worker (ParallelIIR& owner) : ThreadPoolJob ("Parallel IIR"), owner (owner) {};
+
+    void set (int passToSet, float* samplesToSet, int chunkIdxToSet)
+    {
+        pass = passToSet;
+        samples = samplesToSet;
+        chunkIdx = chunkIdxToSet;
+    }
+
+    JobStatus runJob() override
+    {
+        owner.runChunk (pass, samples, chunkIdx);
+        if (--owner.numWorkersLeft == 0)
+            owner.workersDone.signal();
+        return jobHasFinished;
+    }
+
+private:
+    ParallelIIR& owner;
+    int pass = 1;
+    float* samples = nullptr;
+    int chunkIdx = 0;
+};
+
+//==============================================================================
+ParallelIIR::ParallelIIR (int numChannels, int numThreads)
+{
+    for (int k = 0; k <= order; ++k)
+    {
+        b[k] = 0;
+        a[k] = 0;
+    }
+
+    states.resize (numChannels);
+    chunks.resize (jmax (1, numThreads));
+    if (numThreads > 1)
+    {
+        threadPool = std::make_unique<ThreadPool> (numThreads - 1);
+        for (int i = 0; i < numThreads - 1; ++i)
+            workers.push_back (std::make_unique<Worker> (*this));
+    }
+    reset();
+}
+
+ParallelIIR::~ParallelIIR()
+{
+    if (threadPool != nullptr)
+        threadPool->removeAllJobs (true, 1000);
+}
+
+void ParallelIIR::setCoefficients (const std::vector<double>& coefficientsToSet)
+{
+    numeratorOrder = 0;
+    denominatorOrder = 0;
+    for (int k = 0; k <= order; ++k)
+    {
+        b[k] = coefficientsToSet[k];
+        a[k] = coefficientsToSet[k + order + 1];
+        if (k > 0 && b[k] != 0)
+            numeratorOrder = k;
+        if (k > 0 && a[k] != 0)
+            denominatorOrder = k;
+    }
+}
+
+void ParallelIIR::reset()
+{
+    for (auto& state : states)
+        for (int k = 0; k < order; ++k)
+        {
+            state.xState[k] = 0;
+            state.yState[k] = 0;
+        }
+}
+
+void ParallelIIR::process (float* const* channels, int numSamples)
+{
+    int64 startTicks = Time::getHighResolutionTicks();
+
+    for (int ch = 0; ch < static_cast<int> (states.size()); ++ch)
+        process (channels[ch], states[ch], numSamples);
+
+    totalTicks += Time::getHighResolutionTicks() - startTicks;
+    totalChannelSamples += static_cast<int64> (states.size()) * numSamples;
+}
+
+double ParallelIIR::getChannelSamplesPerSecond() const
+{
+    return totalTicks > 0 ? totalChannelSamples / Time::highResolutionTicksToSeconds (totalTicks) : 0.0;
+}
+
+void ParallelIIR::process (float* samples, State& state, int numSamples)
+{
+    int numChunks = jlimit (1, static_cast<int> (chunks.size()), numSamples / Global::parallelIIRMinChunkSize);
+    if (numChunks == 1)
+    {
+        IIRKernelTable<float>::get (numeratorOrder, denominatorOrder) (b, a, state.xState, state.yState, samples, samples, numSamples);
+        return;
+    }
+
+    // the past inputs of every chunk and of the next block, before the filter overwrites them
+    int chunkLength = numSamples / numChunks;
+    for (int j = 0; j < numChunks; ++j)
+    {
+        Chunk& chunk = chunks[j];
+        chunk.start = j * chunkLength;
+        chunk.length = j == numChunks - 1 ? numSamples - chunk.start : chunkLength;
+        for (int k = 0; k < order; ++k)
+        {
+            chunk.startState.xState[k] = j == 0 ? state.xState[k] : static_cast<double> (samples[chunk.start - 1 - k]);
+            chunk.startState.yState[k] = j == 0 ? state.yState[k] : 0.0;
+        }
+    }
+    for (int k = 0; k < order; ++k)
+        state.xState[k] = samples[numSamples - 1 - k];
+
+    runPass (1, samples, numChunks);
+
+    // pass 2: the real outputs before every chunk, the outputs at the end of a chunk are those of
+    // pass 1 plus the power of the companion matrix times the outputs before it
+    Matrix power, lastPower;
+    getCompanionPower (chunkLength, power);
+    getCompanionPower (chunks[numChunks - 1].length, lastPower);
+
+    double yReal[order];
+    for (int k = 0; k < order; ++k)
+        yReal[k] = chunks[0].yEnd[k];
+
+    for (int j = 1; j < numChunks; ++j)
+    {
+        Chunk& chunk = chunks[j];
+        const Matrix& chunkPower = j == numChunks - 1 ? lastPower : power;
+        for (int k = 0; k < order; ++k)
+            chunk.startState.yState[k] = yReal[k];
+        for (int i = 0; i < order; ++i)
+        {
+            yReal[i] = chunk.yEnd[i];
+            for (int k = 0; k < order; ++k)
+                yReal[i] += chunkPower[i][k] * chunk.startState.yState[k];
+        }
+    }
+    for (int k = 0; k < order; ++k)
+        state.yState[k] = yReal[k];
+
+    runPass (3, samples, numChunks);
+}
+
+void ParallelIIR::runPass (int pass, float* samples, int numChunks)
+{
+    numWorkersLeft = numChunks - 1;
+    for (int j = 1; j < numChunks; ++j)
+    {
+        workers[j - 1]->set (pass, samples, j);
+        threadPool->addJob (workers[j - 1].get(), false);
+    }
+    runChunk (pass, samples, 0);
+    workersDone.wait();
+
+    // the pool only lets go of a job after runJob() has returned, and a job it still holds cannot be added again
+    for (int j = 1; j < numChunks; ++j)
+        threadPool->waitForJobToFinish (workers[j - 1].get(), -1);
+}
+
+void ParallelIIR::runChunk (int pass, float* samples, int chunkIdx)
+{
+    if (pass == 1)
+        filterChunk (samples, chunks[chunkIdx]);
+    else if (chunkIdx > 0) // the first chunk started from the real state
+        correctChunk (samples, chunks[chunkIdx]);
+}
+
+void ParallelIIR::filterChunk (float* samples, Chunk& chunk)
+{
+    State state = chunk.startState;
+    IIRKernelTable<float>::get (numeratorOrder, denominatorOrder) (b, a, state.xState, state.yState,
+                                                                   samples + chunk.start, samples + chunk.start, chunk.length);
+    for (int k = 0; k < order; ++k)
+        chunk.yEnd[k] = state.yState[k];
+}
+
+void ParallelIIR::correctChunk (float* samples, const Chunk& chunk)
+{
+    const double a1 = a[1], a2 = a[2], a3 = a[3], a4 = a[4], a5 = a[5];
+
+    // the error in the past outputs is the real past output, as pass 1 started from zero
+    double e1 = chunk.startState.yState[0], e2 = chunk.startState.yState[1], e3 = chunk.startState.yState[2];
+    double e4 = chunk.startState.yState[3], e5 = chunk.startState.yState[4];
+
+    double largest = jmax (std::abs (e1), std::abs (e2), std::abs (e3), jmax (std::abs (e4), std::abs (e5)));
+    const double threshold = largest * Global::parallelIIRCorrectionFloor;
+
+    float* output = samples + chunk.start;
+    for (int start = 0; start < chunk.length; start += Global::parallelIIRCheckInterval)
+    {
+        int end = jmin (start + Global::parallelIIRCheckInterval, chunk.length);
+        for (int n = start; n < end; ++n)
+        {
+            double e0 = a1 * e1 + a2 * e2 + a3 * e3 + a4 * e4 + a5 * e5;
+            e5 = e4; e4 = e3; e3 = e2; e2 = e1; e1 = e0;
+            output[n] = static_cast<float> (output[n] + e0);
+        }
+
+        // adding the rest would not change the output any more
+        if (jmax (std::abs (e1), std::abs (e2), std::abs (e3), jmax (std::abs (e4), std::abs (e5))) <= threshold)
+            break;
+    }
+}
+
+void ParallelIIR::getCompanionPower (int exponent, Matrix& result) const
+{
+    // the past outputs go from [y[n-1] ... y[n-5]] to [a1 y[n-1] + ... + a5 y[n-5], y[n-1] ... y[n-4]]
+    Matrix companion;
+    for (int i = 0; i < order; ++i)
+        for (int k = 0; k < order; ++k)
+        {
+            companion[i][k] = i == 0 ? a[k + 1] : (k == i - 1 ? 1.0 : 0.0);
+            result[i][k] = i == k ? 1.0 : 0.0;
+        }
+
+    // by squaring
+    Matrix temp;
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+        {
+            multiply (result, companion, temp);
+            std::memcpy (result, temp, sizeof (Matrix));
+        }
+        exponent >>= 1;
+        if (exponent > 0)
+        {
+            multiply (companion, companion, temp);
+            std::memcpy (companion, temp, sizeof (Matrix));
+        }
+    }
+}
+
+void ParallelIIR::multiply (const Matrix& left, const Matrix& right, Matrix& result)
+{
+    for (int i = 0; i < order; ++i)
+        for (int k = 0; k < order; ++k)
+        {
+            result[i][k] = 0;
+            for (int j = 0; j < order; ++j)
+                result[i][k] += left[i][j] * right[j][k];
+        }
+}
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    ParallelIIR.h
+    Created: 18 Oct 2026 9:06:05pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include "FilterEngine.h"
+#include <atomic>
+
+using namespace juce;
+//==============================================================================
+/*
+    Filters long blocks of a few channels on several cores, although the
+    recursion itself is serial. Every block is split into one chunk per thread:
+
+    1.  All chunks are filtered at the same time. The first starts from the
+        real state, the others from the real past inputs but with zero past
+        outputs.
+    2.  The error of a chunk only depends on its five missing past outputs,
+        and it follows y[n] = a1 y[n-1] + ... + a5 y[n-5] without any input.
+        The real past outputs are passed from chunk to chunk on the calling
+        thread by multiplying with the L-th power of the companion matrix of
+        that recursion, for a chunk of length L.
+    3.  All chunks but the first add their error at the same time. For a
+        stable filter the error dies out, and the pass stops once it is below
+        the rounding error.
+
+    The result is the same as that of FilterEngine up to rounding.
+*/
+class ParallelIIR
+{
+public:
+    // numThreads includes the calling thread
+    ParallelIIR (int numChannels, int numThreads);
+    ~ParallelIIR();
+
+    // takes effect at once
+    void setCoefficients (const std::vector<double>& coefficientsToSet);
+    void reset();
+
+    // filters the channels in place, one after the other, every one of them on all threads
+    void process (float* const* channels, int numSamples);
+
+    // of all process() calls so far
+    double getChannelSamplesPerSecond() const;
+
+    static const int order = FilterEngine::order;
+
+private:
+    struct State
+    {
+        double xState[order]; // x[n-1] ... x[n-5]
+        double yState[order]; // y[n-1] ... y[n-5]
+    };
+
+    struct Chunk
+    {
+        int start = 0;
+        int length = 0;
+        State startState; // before pass 2 the outputs are zero except in the first chunk
+        double yEnd[order]; // the outputs at the end after pass 1
+    };
+
+    class Worker;
+
+    void process (float* samples, State& state, int numSamples);
+
+    // runs pass 1 or pass 3 on all chunks
+    void runPass (int pass, float* samples, int numChunks);
+    void runChunk (int pass, float* samples, int chunkIdx);
+
+    void filterChunk (float* samples, Chunk& chunk);
+    void correctChunk (float* samples, const Chunk& chunk);
+
+    typedef double Matrix[order][order];
+    void getCompanionPower (int exponent, Matrix& result) const;
+    static void multiply (const Matrix& left, const Matrix& right, Matrix& result);
+
+    double b[order + 1];
+    double a[order + 1]; // a[0] is not used
+    int numeratorOrder = 0;
+    int denominatorOrder = 0;
+
+    std::vector<State> states;
+    std::vector<Chunk> chunks;
+
+    std::unique_ptr<ThreadPool> threadPool;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<int> numWorkersLeft { 0 };
+    WaitableEvent workersDone;
+
+    int64 totalTicks = 0;
+    int64 totalChannelSamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelIIR)
+};
@@ -18,27 +18,18 @@ PhaseResponse::PhaseResponse (double fs) : AppComponent ("Phase Response", false
     // initialise any special settings that your component needs.
     phaseData.resize (Global::fftOrder);
     
-    gridLineCoords.resize (32);
-    int m = 10;
-    int n = 0;
-    for (int i = 1; i <= gridLineCoords.size(); ++i)
-    {
-        ++n;
-        double y = m * n;
-        gridLineCoords[i-1] = log(y * (logBase - 1.0) / (fs * 0.5) + 1.0) / log(logBase);
-        if (n % 10 == 0)
-        {
-            m *= 10;
-            n = 0;
-        }
-        
-    }
+    calculateGridLines();
     
     logPlotButton = std::make_unique<TextButton> ();
     logPlotButton->setButtonText (logPlot ? "Lin. plot" : "Log. plot");
     logPlotButton->addListener (this);
     addAndMakeVisible (logPlotButton.get());
     
+    unwrapButton = std::make_unique<TextButton> ();
+    unwrapButton->setButtonText (unwrap ? "Wrap" : "Unwrap");
+    unwrapButton->addListener (this);
+    addAndMakeVisible (unwrapButton.get());
+    
     //// Labels ////
     phaseLabel = std::make_unique<Label> ("Phase", "Phase (deg)");
     phaseLabel->setColour(Label::textColourId, Colours::black);
@@ -67,6 +58,31 @@ PhaseResponse::~PhaseResponse()
 {
 }
 
+void PhaseResponse::setSampleRate (double sampleRate)
+{
+    fs = sampleRate;
+    calculateGridLines();
+    repaint();
+}
+
+void PhaseResponse::calculateGridLines()
+{
+    gridLineCoords.resize (32);
+    int m = 10;
+    int n = 0;
+    for (int i = 1; i <= gridLineCoords.size(); ++i)
+    {
+        ++n;
+        double y = m * n;
+        gridLineCoords[i-1] = log(y * (logBase - 1.0) / (fs * 0.5) + 1.0) / log(logBase);
+        if (n % 10 == 0)
+        {
+            m *= 10;
+            n = 0;
+        }
+    }
+}
+
 void PhaseResponse::paint (juce::Graphics& g)
 {
     /* This demo code just fills the component's background and
@@ -77,8 +93,11 @@ void PhaseResponse::paint (juce::Graphics& g)
      */
     drawAppComp (g);
     
+    zeroDbHeight = plotYStart + highestPhase * plotHeight / (highestPhase - lowestPhase);
+    
     //// Draw zero DB line ////
-    g.drawLine (Global::axisMargin + Global::margin, zeroDbHeight, getWidth(), zeroDbHeight, 1.0);
+    if (lowestPhase <= 0 && highestPhase >= 0)
+        g.drawLine (Global::axisMargin + Global::margin, zeroDbHeight, getWidth(), zeroDbHeight, 1.0);
     
     double plotWidth = getWidth() - (Global::axisMargin + Global::margin);
     
@@ -160,13 +179,13 @@ void PhaseResponse::paint (juce::Graphics& g)
                 getWidth(),
                 getHeight() - Global::axisMargin - Global::margin);
     
-    g.drawText ("180",
+    g.drawText (String (roundToInt (highestPhase * 180.0 / double_Pi)),
                 0.0f,
                 plotYStart - equationFont.getHeight() * 0.5,
                 Global::axisMargin + Global::margin * 0.5,
                 equationFont.getHeight(), Justification::centredRight, false);
     
-    g.drawText ("-180",
+    g.drawText (String (roundToInt (lowestPhase * 180.0 / double_Pi)),
                 0.0f,
                 plotYStart + plotHeight - equationFont.getHeight() * 0.5,
                 Global::axisMargin + Global::margin * 0.5,
@@ -178,9 +197,8 @@ void PhaseResponse::resized()
 {
     // This method is where you should set the bounds of any child
     // components that your component contains..
-    zeroDbHeight = (getHeight() - Global::axisMargin - Global::margin - plotYStart) * 0.5 + plotYStart;
-
     logPlotButton->setBounds (getWidth() - 100 - Global::margin, Global::margin, 100, 25);
+    unwrapButton->setBounds (getWidth() - 170 - Global::margin, Global::margin, 65, 25);
     if (Global::showPhaseValue)
         valueLabel->setBounds (getWidth() * 0.5, Global::margin, 100, 100);
 
@@ -200,22 +218,29 @@ void PhaseResponse::resized()
 Path PhaseResponse::generateResponsePath()
 {
     Path response;
-    float visualScaling = (getHeight() - Global::axisMargin - Global::margin - plotYStart) / (2.0 * double_Pi);
+    float visualScaling = plotHeight / (highestPhase - lowestPhase);
     
-    //response.startNewSubPath(0, -dBData[0] * visualScaling + zeroDbHeight);
-    response.startNewSubPath (Global::margin + Global::axisMargin, (isnan(phaseData[0]) ? 0.0 : -phaseData[0] * visualScaling) + zeroDbHeight); // draw RT instead of filter magnitude
     auto spacing = (getWidth() - Global::margin - Global::axisMargin) / static_cast<double> (phaseData.size());
     double x = Global::margin + Global::axisMargin;
-    float newY;
-    for (int y = 0; y < data.size(); y++)
+    bool startNewSubPath = true;
+    for (int i = 0; i < phaseData.size(); ++i)
     {
-        newY = -phaseData[y] * visualScaling + zeroDbHeight;
-        if (isnan(newY))
-            continue;
-        response.lineTo(x, newY);
+        // there is no phase at zeros on the unit circle, so leave a gap
+        if (isnan (phaseData[i]))
+        {
+            startNewSubPath = true;
+        }
+        else
+        {
+            float newY = -phaseData[i] * visualScaling + zeroDbHeight;
+            if (startNewSubPath)
+                response.startNewSubPath (x, newY);
+            else
+                response.lineTo (x, newY);
+            startNewSubPath = false;
+        }
         x += spacing;
     }
-    response.lineTo (getWidth(), isnan(newY) ? zeroDbHeight : newY);
     
     return response;
 }
@@ -223,61 +248,74 @@ Path PhaseResponse::generateResponsePath()
 void PhaseResponse::calculate()
 {
     phaseIsNan = false;
-    std::complex<double> i (0.0, 1.0);
-    std::complex<double> omega (0.0, 0.0);
+    responseEngine->setLogGrid (logPlot, logBase);
+    responseEngine->calculate (coefficients);
+    const std::vector<std::complex<double>>& response = responseEngine->getResponse();
     
-    for (int k = 1; k <= Global::fftOrder; ++k)
+    for (int k = 0; k < Global::fftOrder; ++k)
     {
-        double linearVal = k / static_cast<double>(Global::fftOrder);
-        if (logPlot)
-            omega.real (double_Pi * ((pow (logBase, linearVal) - 1.0) / (logBase - 1.0)));
-        else
-            omega.real (double_Pi * linearVal);
-        
-        
-        std::complex<double> numerator (0.0, 0.0);
-        std::complex<double> denominator (1.0, 0.0);
-        
-        for (int j = 0; j < Global::numCoeffs * 0.5; ++j)
-        {
-            if (coefficients[j] == 0)
-                continue;
-            numerator += coefficients[j] * exp(-i * omega * std::complex<double>(j));
-            
-        }
-        for (int j = 1; j < Global::numCoeffs * 0.5; ++j)
-        {
-            if (coefficients[j + Global::numCoeffs * 0.5] == 0)
-                continue;
-            denominator -= coefficients[j + Global::numCoeffs * 0.5] * exp(-i * omega * std::complex<double>(j));
-        }
-        data[k-1] = numerator / denominator;
-        if (data[k-1].real() == 0)
-            phaseIsNan = true;
+        data[k] = response[k];
     }
-    // if the real part of the data is 0, set all phase data to 0;
-//    if (phaseIsNan)
-//    {
-//        phaseData.clear();
-//        phaseData.resize (Global::fftOrder, 0.0);
-//    } else {
     linearGainToPhase();
-//    }
 }
 
 void PhaseResponse::buttonClicked (Button* button)
 {
-    logPlot = !logPlot;
-    logPlotButton->setButtonText (logPlot ? "Lin. plot" : "Log. plot");
+    if (button == unwrapButton.get())
+    {
+        unwrap = !unwrap;
+        unwrapButton->setButtonText (unwrap ? "Wrap" : "Unwrap");
+    }
+    else
+    {
+        logPlot = !logPlot;
+        logPlotButton->setButtonText (logPlot ? "Lin. plot" : "Log. plot");
+    }
     refresh();
 }
 
 void PhaseResponse::linearGainToPhase()
 {
+    ResponseEngine::unwrapPhase (data, phaseData, unwrap);
+    
+    phaseIsNan = false;
+    for (int i = 0; i < Global::fftOrder; ++i)
+        if (isnan (phaseData[i]))
+            phaseIsNan = true;
+    
+    if (unwrap)
+    {
+        highestPhase = -std::numeric_limits<double>::max();
+        lowestPhase = std::numeric_limits<double>::max();
+        for (int i = 0; i < Global::fftOrder; ++i)
+        {
+            if (isnan (phaseData[i]))
+                continue;
+            highestPhase = std::max (phaseData[i], highestPhase);
+            lowestPhase = std::min (phaseData[i], lowestPhase);
+        }
+        
+        // show at least half a turn so a flat phase is not blown up
+        if (highestPhase < lowestPhase)
+        {
+            highestPhase = double_Pi;
+            lowestPhase = -double_Pi;
+        }
+        else if (highestPhase - lowestPhase < double_Pi)
+        {
+            double centre = 0.5 * (highestPhase + lowestPhase);
+            highestPhase = centre + 0.5 * double_Pi;
+            lowestPhase = centre - 0.5 * double_Pi;
+        }
+        return;
+    }
+    
+    highestPhase = double_Pi;
+    lowestPhase = -double_Pi;
+    
     int phaseSign = 0;
     for (int i = 0; i < Global::fftOrder; ++i)
     {
-        phaseData[i] = std::atan2 (data[i].imag(), data[i].real());
         if (round(abs(phaseData[i]) * 10000) / 10000.0 == round(float_Pi * 10000) / 10000.0 )
         {
             if (phaseSign == 0)
@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include "Global.h"
 #include "AppComponent.h"
+#include "ResponseEngine.h"
 #include <complex>
 #include <math.h>
 
@@ -19,13 +20,18 @@ public:
     void resized() override;
     
     void calculate() override;
+    void setRoots (const std::vector<std::complex<double>>& zeros, const std::vector<std::complex<double>>& poles) override { responseEngine->setRoots (zeros, poles); };
     Path generateResponsePath();
     void linearGainToPhase();
     
     void buttonClicked (Button* button) override;
     void mouseMove (const MouseEvent& e) override;
 
+    void setSampleRate (double sampleRate) override;
+
 private:
+    void calculateGridLines();
+
     std::vector<double> phaseData;
     std::vector<double> gridLineCoords;
     
@@ -39,10 +45,17 @@ private:
     
     bool phaseIsNan = false;
     std::unique_ptr<TextButton> logPlotButton;
+    
+    bool unwrap = false;
+    double highestPhase = double_Pi;
+    double lowestPhase = -double_Pi;
+    std::unique_ptr<TextButton> unwrapButton;
         
     std::unique_ptr<Label> phaseLabel;
     std::unique_ptr<Label> freqLabel;
     
     std::unique_ptr<Label> valueLabel;
+    
+    SharedResourcePointer<ResponseEngine> responseEngine; // shared by the phase response and the group delay
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PhaseResponse)
 };
@@ -20,10 +20,31 @@ PoleZeroPlot::PoleZeroPlot() : AppComponent ("Pole-Zero Plot", false)
     zoomButton->setButtonText ("Zoom out");
     addAndMakeVisible (zoomButton.get());
     zoomButton->addListener (this);
+    
+    locusBox = std::make_unique<ComboBox> ();
+    locusBox->setTextWhenNothingSelected ("Root locus");
+    locusBox->addItem ("Off", 1);
+    for (int i = 0; i < Global::numCoeffs; ++i)
+    {
+        bool isACoeff = i >= Global::numCoeffs * 0.5;
+        if (i == Global::numCoeffs * 0.5) // a0 is always 1
+            continue;
+        locusBox->addItem ((isACoeff ? "a" : "b") + String (static_cast<int> (isACoeff ? i - Global::numCoeffs * 0.5 : i)), i + 2);
+    }
+    locusBox->addListener (this);
+    addAndMakeVisible (locusBox.get());
+    
+    heatmapButton = std::make_unique<TextButton> ("Heatmap");
+    heatmapButton->setButtonText ("Show |H(z)|");
+    addAndMakeVisible (heatmapButton.get());
+    heatmapButton->addListener (this);
+    
+    heatmap.addChangeListener (this);
 }
 
 PoleZeroPlot::~PoleZeroPlot()
 {
+    heatmap.removeChangeListener (this);
 }
 
 void PoleZeroPlot::paint (juce::Graphics& g)
@@ -46,17 +67,15 @@ void PoleZeroPlot::paint (juce::Graphics& g)
         default:
             break;
     }
+    if (showHeatmap)
+        heatmap.draw (g, getLocalBounds().toFloat());
+    
     drawAppComp (g);
     
     
     double diameter = getWidth() - 2.0 * (Global::pzAxisMargin + Global::margin);
     
-    AffineTransform transform;
-    float zoomfactor = zoomed ? scaling : 1.0;
-//    transform = transform.scaled ((zoomed ? 1.0 : scaling), (zoomed ? 1.0 : scaling), 150, 150);
-    transform = transform.scaled (zoomfactor, zoomfactor, 150, 150);
-
-    g.addTransform (transform);
+    g.addTransform (getZoomTransform());
 
     // draw unit circle
     g.setColour (Colours::grey);
@@ -68,6 +87,13 @@ void PoleZeroPlot::paint (juce::Graphics& g)
     g.drawLine (getWidth() * 0.5, Global::margin + 0.5 * Global::pzAxisMargin, getWidth() * 0.5, getHeight() - Global::margin - 0.5 * Global::pzAxisMargin);
     g.drawLine (Global::margin + 0.5 * Global::pzAxisMargin, getHeight() * 0.5, getWidth() - Global::margin - 0.5 * Global::pzAxisMargin, getHeight() * 0.5);
     
+    // draw root locus
+    if (locusCoeffIdx != -1)
+    {
+        g.setColour (Colours::blue.withAlpha (0.5f));
+        g.strokePath (locusPath, PathStrokeType (1.0f));
+    }
+    
     g.setColour (Colours::black);
     highestXOrder += highestXOrder == 0 ? 1 : 0;
     for (int i = 0; i < highestXOrder; ++i)
@@ -107,11 +133,46 @@ void PoleZeroPlot::resized()
     // This method is where you should set the bounds of any child
     // components that your component contains..
     zoomButton->setBounds (getWidth() - Global::margin - 100, Global::margin, 100, 20);
+    locusBox->setBounds (Global::margin, getHeight() - Global::margin - 20, 100, 20);
+    heatmapButton->setBounds (getWidth() - Global::margin - 100, getHeight() - Global::margin - 20, 100, 20);
+    generateLocusPath();
+    updateHeatmap();
 }
 
 void PoleZeroPlot::calculate()
 {
-    // x roots
+    // while a root is dragged, the roots are set by the drag and the coefficients follow from them
+    if (dragIdx == -1)
+    {
+        if (changeMask & FilterModel::numeratorMask)
+            findZeros();
+        if (changeMask & FilterModel::denominatorMask)
+            findPoles();
+    }
+    updateStability();
+    
+    if (locusCoeffIdx != -1)
+        calculateRootLocus();
+    
+    updateHeatmap();
+}
+
+void PoleZeroPlot::findZeros()
+{
+    // the zeros only depend on the b coefficients
+    std::vector<double> numerator (coefficients.getVector().begin(), coefficients.getVector().begin() + Global::numCoeffs * 0.5);
+    AnalysisCache::Key key ("zeros", numerator);
+    if (auto roots = analysisCache->get<Roots> (key))
+    {
+        realZeroVector = roots->real;
+        imaginaryZeroVector = roots->imag;
+        xCoeffs = roots->polynomial;
+        highestXOrder = roots->highestOrder;
+        numZeros = roots->numRoots;
+        zeroGain = roots->gain;
+        return;
+    }
+    
     highestXOrder = 0;
     for (int i = Global::numCoeffs * 0.5 - 1; i >= 0; --i)
     {
@@ -143,7 +204,30 @@ void PoleZeroPlot::calculate()
                            &imaginaryZeroVector[0],
                            &numberOfXRoots);
     
-    // y roots
+    // leading zero coefficients lower the degree of the polynomial
+    numZeros = xPolynomial.Degree();
+    zeroGain = xPolynomial[numZeros];
+    
+    auto roots = std::make_shared<Roots>();
+    *roots = { realZeroVector, imaginaryZeroVector, xCoeffs, highestXOrder, numZeros, zeroGain };
+    analysisCache->put<Roots> (key, roots, sizeof (Roots) + 3 * AnalysisCache::getVectorBytes (xCoeffs));
+}
+
+void PoleZeroPlot::findPoles()
+{
+    // the poles only depend on the a coefficients
+    std::vector<double> denominator (coefficients.getVector().begin() + Global::numCoeffs * 0.5, coefficients.getVector().end());
+    AnalysisCache::Key key ("poles", denominator);
+    if (auto roots = analysisCache->get<Roots> (key))
+    {
+        realPoleVector = roots->real;
+        imaginaryPoleVector = roots->imag;
+        yCoeffs = roots->polynomial;
+        highestYOrder = roots->highestOrder;
+        numPoles = roots->numRoots;
+        return;
+    }
+    
     highestYOrder = 0;
     for (int i = Global::numCoeffs - 1; i >= Global::numCoeffs * 0.5; --i)
     {
@@ -176,21 +260,31 @@ void PoleZeroPlot::calculate()
     yPolynomial.FindRoots (&realPoleVector[0],
                            &imaginaryPoleVector[0],
                            &numberOfYRoots);
+    numPoles = yPolynomial.Degree();
     
+    auto roots = std::make_shared<Roots>();
+    *roots = { realPoleVector, imaginaryPoleVector, yCoeffs, highestYOrder, numPoles, 1.0 };
+    analysisCache->put<Roots> (key, roots, sizeof (Roots) + 3 * AnalysisCache::getVectorBytes (yCoeffs));
+}
+
+void PoleZeroPlot::updateStability()
+{
     // for background colour drawing
-    unstable = -1;
+    // the audio thread only sees the final result
+    int stability = -1;
     for (int i = 0; i < Global::numCoeffs * 0.5; ++i)
     {
         // because we're comparing floats with integers, this is how we add a range of 0.0001;
         float poleMagnitude = round((sqrt (realPoleVector[i] * realPoleVector[i] + imaginaryPoleVector[i] * imaginaryPoleVector[i]) * 10000.0)) / 10000.0;
         if (poleMagnitude == 1)
-            unstable = 0;
+            stability = 0;
         if (poleMagnitude > 1)
         {
-            unstable = 1;
+            stability = 1;
             break;
         }
     }
+    unstable = stability;
     
     float maxDist = 1;
     
@@ -221,7 +315,389 @@ void PoleZeroPlot::calculate()
 
 void PoleZeroPlot::buttonClicked (Button* button)
 {
-    zoomed = !zoomed;
-    zoomButton->setButtonText (zoomed ? "Zoom in" : "Zoom out");
+    if (button == heatmapButton.get())
+    {
+        showHeatmap = !showHeatmap;
+        heatmapButton->setButtonText (showHeatmap ? "Hide |H(z)|" : "Show |H(z)|");
+        if (!showHeatmap)
+            heatmap.stop();
+    }
+    else
+    {
+        zoomed = !zoomed;
+        zoomButton->setButtonText (zoomed ? "Zoom in" : "Zoom out");
+    }
+    updateHeatmap();
+    repaint();
+}
+
+void PoleZeroPlot::changeListenerCallback (ChangeBroadcaster* source)
+{
+    // a tile of the heatmap is done
+    if (showHeatmap)
+        repaint();
+}
+
+void PoleZeroPlot::updateHeatmap()
+{
+    if (!showHeatmap || getWidth() <= 0 || getHeight() <= 0)
+        return;
+    
+    // the part of the z-plane that is visible with the current zoom
+    double radius = 0.5 * (getWidth() - 2.0 * (Global::pzAxisMargin + Global::margin));
+    Rectangle<float> visible = getLocalBounds().toFloat().transformedBy (getZoomTransform().inverted());
+    heatmap.calculate (coefficients,
+                       (visible.getX() - getWidth() * 0.5) / radius,
+                       (visible.getRight() - getWidth() * 0.5) / radius,
+                       -(visible.getBottom() - getHeight() * 0.5) / radius,
+                       -(visible.getY() - getHeight() * 0.5) / radius,
+                       getWidth(), getHeight());
+}
+
+void PoleZeroPlot::comboBoxChanged (ComboBox* comboBox)
+{
+    int coeffIdx = locusBox->getSelectedId() - 2; // id 1 is "Off"
+    if (coeffIdx < 0)
+    {
+        setRootLocus (-1, 0, 0, 0);
+        return;
+    }
+    setRootLocus (coeffIdx, coefficients[coeffIdx] - Global::locusRange, coefficients[coeffIdx] + Global::locusRange, Global::locusSteps);
+}
+
+void PoleZeroPlot::setRootLocus (int coeffIdx, double from, double to, int numSteps)
+{
+    locusCoeffIdx = coeffIdx;
+    locusFrom = from;
+    locusTo = to;
+    locusSteps = numSteps;
+    calculateRootLocus();
     repaint();
 }
+
+void PoleZeroPlot::calculateRootLocus()
+{
+    numLocusRoots = 0;
+    locusPath.clear();
+    if (locusCoeffIdx == -1 || locusSteps < 2)
+        return;
+    
+    int halfNumCoeffs = Global::numCoeffs * 0.5;
+    bool isPole = locusCoeffIdx >= halfNumCoeffs;
+    int offset = isPole ? halfNumCoeffs : 0;
+    
+    // order of the polynomial over the whole sweep
+    int order = locusCoeffIdx - offset;
+    for (int i = order + 1; i < halfNumCoeffs; ++i)
+        if (coefficients[i + offset] != 0)
+            order = i;
+    
+    // leading zero b coefficients lower the degree like in findZeros(), the swept one is only zero at a single step
+    int lowestIdx = 0;
+    while (! isPole && lowestIdx < order && lowestIdx != locusCoeffIdx && coefficients[lowestIdx] == 0)
+        ++lowestIdx;
+    int degree = order - lowestIdx;
+    
+    if (degree == 0)
+    {
+        repaint();
+        return;
+    }
+    
+    AnalysisCache::Key key ("root locus", coefficients, { static_cast<double> (locusCoeffIdx), locusFrom, locusTo, static_cast<double> (locusSteps) });
+    if (auto locus = analysisCache->get<Locus> (key))
+    {
+        numLocusRoots = locus->numRoots;
+        locusRealBlock = locus->realBlock;
+        locusImagBlock = locus->imagBlock;
+        locusStatus = locus->status;
+        generateLocusPath();
+        return;
+    }
+    
+    // fill the coefficients of all steps, in reverse order like in findZeros() and findPoles()
+    locusCoefficientBlock.resize ((degree + 1) * locusSteps);
+    for (int s = 0; s < locusSteps; ++s)
+    {
+        double value = locusFrom + (locusTo - locusFrom) * s / static_cast<double> (locusSteps - 1);
+        for (int k = 0; k <= degree; ++k)
+        {
+            int i = order - k;
+            double coefficient = (i + offset == locusCoeffIdx) ? value : coefficients[i + offset];
+            if (isPole)
+                locusCoefficientBlock[k * locusSteps + s] = (i == 0) ? 1.0 : -coefficient;
+            else
+                locusCoefficientBlock[k * locusSteps + s] = coefficient;
+        }
+    }
+    
+    // solve all steps at once, spread over the available cores
+    locusRealBlock.resize (degree * locusSteps);
+    locusImagBlock.resize (degree * locusSteps);
+    locusStatus.resize (locusSteps);
+    PolynomialBatchRootFinder::FindRoots (&locusCoefficientBlock[0], degree, locusSteps,
+                                          &locusRealBlock[0], &locusImagBlock[0], &locusStatus[0]);
+    numLocusRoots = degree;
+    
+    trackLocusRoots (numLocusRoots);
+    generateLocusPath();
+    
+    auto locus = std::make_shared<Locus>();
+    *locus = { numLocusRoots, locusRealBlock, locusImagBlock, locusStatus };
+    analysisCache->put<Locus> (key, locus, sizeof (Locus) + AnalysisCache::getVectorBytes (locus->realBlock)
+                                           + AnalysisCache::getVectorBytes (locus->imagBlock) + AnalysisCache::getVectorBytes (locus->status));
+}
+
+void PoleZeroPlot::trackLocusRoots (int numRoots)
+{
+    // Every step is solved on its own, so the roots can come out in any order. Reorder each step
+    // so that root r is the root closest to root r of the previous step to get continuous trajectories.
+    std::vector<double> stepReal (numRoots);
+    std::vector<double> stepImag (numRoots);
+    std::vector<bool> used (numRoots);
+    
+    int prevStep = -1;
+    for (int s = 0; s < locusSteps; ++s)
+    {
+        if (locusStatus[s] != PolynomialRootFinder::SUCCESS)
+            continue;
+        
+        // roots that are not finite cannot be matched, so the step is left out like a failed one
+        bool isFinite = true;
+        for (int r = 0; r < numRoots; ++r)
+            isFinite = isFinite && std::isfinite (locusRealBlock[r * locusSteps + s]) && std::isfinite (locusImagBlock[r * locusSteps + s]);
+        if (! isFinite)
+        {
+            locusStatus[s] = PolynomialRootFinder::FAILED_TO_CONVERGE;
+            continue;
+        }
+        
+        if (prevStep != -1)
+        {
+            for (int r = 0; r < numRoots; ++r)
+            {
+                stepReal[r] = locusRealBlock[r * locusSteps + s];
+                stepImag[r] = locusImagBlock[r * locusSteps + s];
+                used[r] = false;
+            }
+            
+            for (int r = 0; r < numRoots; ++r)
+            {
+                int closestIdx = -1;
+                double closestDistance = 0.0;
+                for (int c = 0; c < numRoots; ++c)
+                {
+                    if (used[c])
+                        continue;
+                    double distance = std::hypot (stepReal[c] - locusRealBlock[r * locusSteps + prevStep],
+                                                  stepImag[c] - locusImagBlock[r * locusSteps + prevStep]);
+                    if (closestIdx == -1 || distance < closestDistance)
+                    {
+                        closestDistance = distance;
+                        closestIdx = c;
+                    }
+                }
+                used[closestIdx] = true;
+                locusRealBlock[r * locusSteps + s] = stepReal[closestIdx];
+                locusImagBlock[r * locusSteps + s] = stepImag[closestIdx];
+            }
+        }
+        prevStep = s;
+    }
+}
+
+void PoleZeroPlot::generateLocusPath()
+{
+    // the path is cached in unzoomed coordinates and only rebuilt when the locus or the size changes
+    locusPath.clear();
+    double diameter = getWidth() - 2.0 * (Global::pzAxisMargin + Global::margin);
+    for (int r = 0; r < numLocusRoots; ++r)
+    {
+        bool startNewSubPath = true;
+        for (int s = 0; s < locusSteps; ++s)
+        {
+            if (locusStatus[s] != PolynomialRootFinder::SUCCESS)
+            {
+                startNewSubPath = true;
+                continue;
+            }
+            float x = getWidth() * 0.5 + Global::limit (locusRealBlock[r * locusSteps + s], -100, 100) * diameter * 0.5;
+            float y = getHeight() * 0.5 - Global::limit (locusImagBlock[r * locusSteps + s], -100, 100) * diameter * 0.5;
+            if (startNewSubPath)
+                locusPath.startNewSubPath (x, y);
+            else
+                locusPath.lineTo (x, y);
+            startNewSubPath = false;
+        }
+    }
+}
+
+std::vector<std::complex<double>> PoleZeroPlot::getZeros()
+{
+    std::vector<std::complex<double>> zeros;
+    for (int i = 0; i < numZeros; ++i)
+        zeros.push_back (std::complex<double> (realZeroVector[i], imaginaryZeroVector[i]));
+    return zeros;
+}
+
+std::vector<std::complex<double>> PoleZeroPlot::getPoles()
+{
+    std::vector<std::complex<double>> poles;
+    for (int i = 0; i < numPoles; ++i)
+        poles.push_back (std::complex<double> (realPoleVector[i], imaginaryPoleVector[i]));
+    return poles;
+}
+
+AffineTransform PoleZeroPlot::getZoomTransform()
+{
+    AffineTransform transform;
+    float zoomfactor = zoomed ? scaling : 1.0;
+//    transform = transform.scaled ((zoomed ? 1.0 : scaling), (zoomed ? 1.0 : scaling), 150, 150);
+    return transform.scaled (zoomfactor, zoomfactor, 150, 150);
+}
+
+Point<float> PoleZeroPlot::rootToPoint (double real, double imag)
+{
+    double diameter = getWidth() - 2.0 * (Global::pzAxisMargin + Global::margin);
+    Point<float> point (getWidth() * 0.5 + Global::limit (real, -100, 100) * diameter * 0.5,
+                        getHeight() * 0.5 - Global::limit (imag, -100, 100) * diameter * 0.5);
+    return point.transformedBy (getZoomTransform());
+}
+
+bool PoleZeroPlot::findRootAt (Point<float> position, bool& isPole, int& idx)
+{
+    float closestDistance = 8.0f; // pixels
+    idx = -1;
+    for (int i = 0; i < numZeros; ++i)
+    {
+        float distance = position.getDistanceFrom (rootToPoint (realZeroVector[i], imaginaryZeroVector[i]));
+        if (distance < closestDistance)
+        {
+            closestDistance = distance;
+            isPole = false;
+            idx = i;
+        }
+    }
+    for (int i = 0; i < numPoles; ++i)
+    {
+        float distance = position.getDistanceFrom (rootToPoint (realPoleVector[i], imaginaryPoleVector[i]));
+        if (distance < closestDistance)
+        {
+            closestDistance = distance;
+            isPole = true;
+            idx = i;
+        }
+    }
+    return idx != -1;
+}
+
+int PoleZeroPlot::findConjugate (std::vector<double>& realVector, std::vector<double>& imagVector, int numRoots, int idx)
+{
+    if (imagVector[idx] == 0)
+        return -1;
+    
+    int conjugateIdx = -1;
+    double closestDistance = std::numeric_limits<double>::max();
+    for (int i = 0; i < numRoots; ++i)
+    {
+        if (i == idx)
+            continue;
+        double distance = std::abs (std::complex<double> (realVector[i] - realVector[idx], imagVector[i] + imagVector[idx]));
+        if (distance < closestDistance)
+        {
+            closestDistance = distance;
+            conjugateIdx = i;
+        }
+    }
+    return conjugateIdx;
+}
+
+void PoleZeroPlot::rootsToCoefficients()
+{
+    draggedCoefficients = coefficients.getVector();
+    
+    // zeros: the polynomial coefficients are the b coefficients in reverse order
+    Polynomial xPolynomial (1.0);
+    for (int i = 0; i < numZeros; ++i)
+    {
+        if (imaginaryZeroVector[i] == 0)
+            xPolynomial.IncludeRealRoot (realZeroVector[i]);
+        else if (imaginaryZeroVector[i] > 0) // the conjugate with the negative imaginary part is included with it
+            xPolynomial.IncludeComplexConjugateRootPair (realZeroVector[i], imaginaryZeroVector[i]);
+    }
+    xPolynomial *= zeroGain;
+    
+    for (int i = 0; i <= numZeros; ++i)
+        draggedCoefficients[highestXOrder - i] = round (xPolynomial[i] * 1000000.0) / 1000000.0;
+    
+    // poles: the polynomial is monic and the a coefficients have a flipped sign
+    Polynomial yPolynomial (1.0);
+    for (int i = 0; i < numPoles; ++i)
+    {
+        if (imaginaryPoleVector[i] == 0)
+            yPolynomial.IncludeRealRoot (realPoleVector[i]);
+        else if (imaginaryPoleVector[i] > 0)
+            yPolynomial.IncludeComplexConjugateRootPair (realPoleVector[i], imaginaryPoleVector[i]);
+    }
+    
+    for (int i = 1; i <= numPoles; ++i)
+        draggedCoefficients[i + Global::numCoeffs * 0.5] = round (-yPolynomial[numPoles - i] * 1000000.0) / 1000000.0;
+}
+
+void PoleZeroPlot::mouseMove (const MouseEvent& e)
+{
+    bool isPole;
+    int idx;
+    setMouseCursor (findRootAt (e.position, isPole, idx) ? MouseCursor::DraggingHandCursor : MouseCursor::NormalCursor);
+}
+
+void PoleZeroPlot::mouseDown (const MouseEvent& e)
+{
+    if (!findRootAt (e.position, dragIsPole, dragIdx))
+        return;
+    
+    if (dragIsPole)
+        dragConjugateIdx = findConjugate (realPoleVector, imaginaryPoleVector, numPoles, dragIdx);
+    else
+        dragConjugateIdx = findConjugate (realZeroVector, imaginaryZeroVector, numZeros, dragIdx);
+}
+
+void PoleZeroPlot::mouseDrag (const MouseEvent& e)
+{
+    if (dragIdx == -1)
+        return;
+    
+    double diameter = getWidth() - 2.0 * (Global::pzAxisMargin + Global::margin);
+    Point<float> point = e.position.transformedBy (getZoomTransform().inverted());
+    double real = (point.x - getWidth() * 0.5) / (diameter * 0.5);
+    double imag = -(point.y - getHeight() * 0.5) / (diameter * 0.5);
+
+    // real roots stay on the real axis, complex roots move together with their conjugate
+    std::vector<double>& realVector = dragIsPole ? realPoleVector : realZeroVector;
+    std::vector<double>& imagVector = dragIsPole ? imaginaryPoleVector : imaginaryZeroVector;
+    realVector[dragIdx] = real;
+    imagVector[dragIdx] = dragConjugateIdx == -1 ? 0.0 : imag;
+    if (dragConjugateIdx != -1)
+    {
+        realVector[dragConjugateIdx] = real;
+        imagVector[dragConjugateIdx] = -imag;
+    }
+    
+    rootsToCoefficients();
+    updateStability();
+    repaint();
+    sendChangeMessage();
+}
+
+void PoleZeroPlot::mouseUp (const MouseEvent& e)
+{
+    if (dragIdx == -1)
+        return;
+    
+    dragIdx = -1;
+    dragConjugateIdx = -1;
+    
+    // find the roots of the (rounded) coefficients again
+    changeMask |= dragIsPole ? FilterModel::denominatorMask : FilterModel::numeratorMask;
+    refresh();
+}
@@ -14,11 +14,14 @@
 #include "Global.h"
 #include "AppComponent.h"
 #include "Polynomial.h"
+#include "PolynomialBatchRootFinder.h"
+#include "ZPlaneHeatmap.h"
 #include "math.h"
+#include <atomic>
 //==============================================================================
 /*
 */
-class PoleZeroPlot  : public AppComponent, public Button::Listener
+class PoleZeroPlot  : public AppComponent, public Button::Listener, public ComboBox::Listener, public ChangeBroadcaster, public ChangeListener
 {
 public:
     PoleZeroPlot();
@@ -30,10 +33,59 @@ public:
     void calculate() override;
     
     void buttonClicked (Button* button) override;
+    void comboBoxChanged (ComboBox* comboBox) override;
+    void changeListenerCallback (ChangeBroadcaster* source) override;
+    
+    // sweep coefficient coeffIdx from 'from' to 'to' in numSteps steps and show how the roots move (coeffIdx = -1 turns it off)
+    void setRootLocus (int coeffIdx, double from, double to, int numSteps);
     
     bool isStable() { return unstable == -1; };
     
+    void mouseMove (const MouseEvent& e) override;
+    void mouseDown (const MouseEvent& e) override;
+    void mouseDrag (const MouseEvent& e) override;
+    void mouseUp (const MouseEvent& e) override;
+    
+    // coefficients rebuilt from the roots while a pole or zero is dragged
+    const std::vector<double>& getCoefficients() { return draggedCoefficients; };
+    
+    std::vector<std::complex<double>> getZeros();
+    std::vector<std::complex<double>> getPoles();
+    
 private:
+    void findZeros();
+    void findPoles();
+    void updateStability();
+    
+    AffineTransform getZoomTransform();
+    Point<float> rootToPoint (double real, double imag);
+    bool findRootAt (Point<float> position, bool& isPole, int& idx);
+    int findConjugate (std::vector<double>& realVector, std::vector<double>& imagVector, int numRoots, int idx);
+    void rootsToCoefficients();
+    
+    void calculateRootLocus();
+    void trackLocusRoots (int numRoots);
+    void generateLocusPath();
+    
+    void updateHeatmap();
+    
+    // what findZeros(), findPoles() and calculateRootLocus() keep in the analysis cache
+    struct Roots
+    {
+        std::vector<double> real, imag;
+        std::vector<double> polynomial;
+        int highestOrder;
+        int numRoots;
+        double gain;
+    };
+    
+    struct Locus
+    {
+        int numRoots;
+        std::vector<double> realBlock, imagBlock;
+        std::vector<PolynomialRootFinder::RootStatus_T> status;
+    };
+    
     std::vector<double> realZeroVector { Global::numCoeffs * 0.5 - 1, 0 };
     std::vector<double> imaginaryZeroVector { Global::numCoeffs * 0.5 - 1, 0 };
     
@@ -42,14 +94,44 @@ private:
     
     std::vector<double> xCoeffs;
     std::vector<double> yCoeffs;
+    std::vector<double> draggedCoefficients;
     int highestXOrder = 0;
     int highestYOrder = 0;
+    
+    int numZeros = 0;
+    int numPoles = 0;
+    double zeroGain = 1.0;
+    
+    // root that is being dragged (-1 if none) and its complex conjugate (-1 if the root is real)
+    int dragIdx = -1;
+    int dragConjugateIdx = -1;
+    bool dragIsPole = false;
 
-    int unstable = -1; // -1 : stable, 0 : on the edge, 1 : unstable
+    std::atomic<int> unstable { -1 }; // -1 : stable, 0 : on the edge, 1 : unstable, read by the audio thread
     
     bool zoomed = false;
     std::unique_ptr<TextButton> zoomButton;
     
+    // root locus
+    std::unique_ptr<ComboBox> locusBox;
+    int locusCoeffIdx = -1;
+    double locusFrom = 0;
+    double locusTo = 0;
+    int locusSteps = Global::locusSteps;
+    int numLocusRoots = 0;
+    
+    // the roots of every step in structure-of-arrays layout: root r of step s is at r * locusSteps + s
+    std::vector<double> locusCoefficientBlock;
+    std::vector<double> locusRealBlock;
+    std::vector<double> locusImagBlock;
+    std::vector<PolynomialRootFinder::RootStatus_T> locusStatus;
+    Path locusPath;
+    
+    // |H(z)| in dB behind the plot
+    bool showHeatmap = false;
+    std::unique_ptr<TextButton> heatmapButton;
+    ZPlaneHeatmap heatmap;
+    
     float scaling = 1.0;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PoleZeroPlot)
 };
@@ -38,9 +38,101 @@
 #include <math.h>
 #include <assert.h>
 #include <exception>
+#include <utility>
+#include <algorithm>
+#include <complex>
+#include <atomic>
 #include "Polynomial.h"
 #include "PolynomialRootFinder.h"
 
+//======================================================================
+//  Local constants and functions.
+//======================================================================
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  Products where both polynomials have at least this degree are
+    //  calculated with the FFT. Below it the schoolbook convolution
+    //  is faster.
+    //------------------------------------------------------------------
+
+    const int i_DEFAULT_FFT_MULTIPLICATION_THRESHOLD = 256;
+
+    const double d_PI = 3.14159265358979323846;
+
+    std::atomic<int> fft_multiplication_threshold(i_DEFAULT_FFT_MULTIPLICATION_THRESHOLD);
+
+    //------------------------------------------------------------------
+    //  In-place iterative radix-2 FFT. The length of data_vector must
+    //  be a power of two. The inverse transform is scaled by 1 / N.
+    //  The twiddle factors are calculated directly rather than by
+    //  repeated multiplication to keep the rounding error small.
+    //------------------------------------------------------------------
+
+    void TransformInPlace(std::vector<std::complex<double> > & data_vector,
+                          bool inverse_flag)
+    {
+        size_t length = data_vector.size();
+
+        size_t i = 0;
+        size_t j = 0;
+
+        for (i = 1; i < length; ++i)
+        {
+            size_t bit = length >> 1;
+
+            for (; (j & bit) != 0; bit >>= 1)
+            {
+                j ^= bit;
+            }
+
+            j ^= bit;
+
+            if (i < j)
+            {
+                std::swap(data_vector[i], data_vector[j]);
+            }
+        }
+
+        std::vector<std::complex<double> > twiddle_vector(length / 2);
+        double sign = inverse_flag ? 1.0 : -1.0;
+
+        for (i = 0; i < length / 2; ++i)
+        {
+            double angle = sign * 2.0 * d_PI * (double)(i) / (double)(length);
+            twiddle_vector[i] = std::complex<double>(cos(angle), sin(angle));
+        }
+
+        for (size_t span = 2; span <= length; span <<= 1)
+        {
+            size_t half_span = span >> 1;
+            size_t twiddle_step = length / span;
+
+            for (i = 0; i < length; i += span)
+            {
+                for (j = 0; j < half_span; ++j)
+                {
+                    std::complex<double> u = data_vector[i + j];
+                    std::complex<double> v = data_vector[i + j + half_span] * twiddle_vector[j * twiddle_step];
+                    data_vector[i + j] = u + v;
+                    data_vector[i + j + half_span] = u - v;
+                }
+            }
+        }
+
+        if (inverse_flag)
+        {
+            double scale = 1.0 / (double)(length);
+
+            for (i = 0; i < length; ++i)
+            {
+                data_vector[i] *= scale;
+            }
+        }
+    }
+};
+
 //======================================================================
 //  Constructor: Polynomial::Polynomial
 //======================================================================
@@ -152,6 +244,24 @@ Polynomial::Polynomial(const Polynomial & polynomial)
     Copy(polynomial);
 }
 
+//======================================================================
+//  Move Constructor: Polynomial::Polynomial
+//
+//  Abstract:
+//
+//    The coefficients are taken over from the passed polynomial.
+//    The passed polynomial is left without coefficients and must be
+//    assigned to before it is used again.
+//
+//======================================================================
+
+Polynomial::Polynomial(Polynomial && polynomial) noexcept
+  : m_degree(-1)
+  , m_coefficient_vector_ptr(NULL)
+{
+    Move(polynomial);
+}
+
 //======================================================================
 //  Destructor: Polynomial::~Polynomial
 //======================================================================
@@ -813,6 +923,140 @@ void Polynomial::IncludeComplexConjugateRootPair(double real_value, double imag_
     operator *=(temp_polynomial);
 }
 
+//======================================================================
+//  Member Function: Polynomial::FromRoots
+//
+//  Abstract:
+//
+//    This method builds the monic polynomial that has the passed
+//    roots. Every real root becomes a first order factor and every
+//    complex conjugate root pair a second order factor. The factors
+//    are then multiplied pairwise in a product tree, so that the
+//    large products at the top of the tree are of similar degree
+//    and can use the FFT multiplication.
+//
+//    Complex roots are expected to come in conjugate pairs, as
+//    returned by FindRoots. Only the root of each pair with a
+//    positive imaginary part is used.
+//
+//
+//  Input:
+//
+//    real_zero_vector_ptr       A vector with the real parts of the
+//                               roots.
+//
+//    imaginary_zero_vector_ptr  A vector with the imaginary parts of
+//                               the roots. If this is NULL then all
+//                               roots are real.
+//
+//    number_of_roots            The number of roots.
+//
+//
+//  Return Value:
+//
+//    This function returns the polynomial with the passed roots.
+//
+//======================================================================
+
+Polynomial Polynomial::FromRoots(const double * real_zero_vector_ptr,
+                                 const double * imaginary_zero_vector_ptr,
+                                 int number_of_roots)
+{
+    std::vector<Polynomial> factor_vector;
+    factor_vector.reserve(number_of_roots);
+
+    int i = 0;
+
+    for (i = 0; i < number_of_roots; ++i)
+    {
+        double real_value = real_zero_vector_ptr[i];
+        double imag_value = (imaginary_zero_vector_ptr != NULL) ? imaginary_zero_vector_ptr[i] : 0.0;
+
+        if (imag_value == 0.0)
+        {
+            factor_vector.push_back(Polynomial(1.0, - real_value));
+        }
+        else if (imag_value > 0.0)
+        {
+            factor_vector.push_back(Polynomial(1.0,
+                                               -(real_value + real_value),
+                                               real_value * real_value + imag_value * imag_value));
+        }
+    }
+
+    if (factor_vector.empty())
+    {
+        return Polynomial(1.0);
+    }
+
+    //------------------------------------------------------------------
+    //  Multiply neighbouring factors until one polynomial is left.
+    //------------------------------------------------------------------
+
+    size_t number_of_factors = factor_vector.size();
+
+    while (number_of_factors > 1)
+    {
+        size_t j = 0;
+
+        for (j = 0; j + 1 < number_of_factors; j += 2)
+        {
+            factor_vector[j] *= factor_vector[j + 1];
+            factor_vector[j / 2] = std::move(factor_vector[j]);
+        }
+
+        if (j < number_of_factors)
+        {
+            factor_vector[j / 2] = std::move(factor_vector[j]);
+        }
+
+        number_of_factors = (number_of_factors + 1) / 2;
+    }
+
+    return std::move(factor_vector[0]);
+}
+
+//======================================================================
+//  Member Function: Polynomial::SetFftMultiplicationThreshold
+//
+//  Abstract:
+//
+//    This method sets the degree above which operator *= uses the
+//    FFT. A product is calculated with the FFT if both polynomials
+//    have a degree greater than or equal to this value.
+//
+//
+//  Input:
+//
+//    degree    The threshold degree.
+//
+//
+//  Return Value:
+//
+//    The function has no return value.
+//
+//======================================================================
+
+void Polynomial::SetFftMultiplicationThreshold(int degree)
+{
+    fft_multiplication_threshold.store(degree, std::memory_order_relaxed);
+}
+
+//======================================================================
+//  Member Function: Polynomial::GetFftMultiplicationThreshold
+//
+//  Abstract:
+//
+//    This method gets the degree above which operator *= uses the
+//    FFT.
+//
+//======================================================================
+
+int Polynomial::GetFftMultiplicationThreshold()
+{
+    return fft_multiplication_threshold.load(std::memory_order_relaxed);
+}
+
 //======================================================================
 //  Member Function: Polynomial::Divide
 //
@@ -848,6 +1092,53 @@ bool Polynomial::Divide(const Polynomial & divisor_polynomial,
                         Polynomial & quotient_polynomial,
                         Polynomial & remainder_polynomial) const
 {
+    quotient_polynomial = *this;
+    return quotient_polynomial.DivideInPlace(divisor_polynomial, remainder_polynomial);
+}
+
+//======================================================================
+//  Member Function: Polynomial::DivideInPlace
+//
+//  Abstract:
+//
+//    This method divides this polynomial by a passed divisor
+//    polynomial and replaces this polynomial with the quotient
+//    polynomial. The remainder polynomial is stored in the passed
+//    instance remainder_polynomial. The division reuses this
+//    polynomial's coefficient buffer, so no buffer is allocated
+//    for the quotient.
+//
+//
+//  Input:
+//
+//    divisor_polynomial      The divisor polynomial
+//
+//    remainder_polynomial    A reference to an instance of class
+//                            Polynomial that will contain the remainder
+//                            polynomial when this method returns. This
+//                            must not be this polynomial.
+//
+//  Return Value:
+//
+//    This function returns a value of type 'bool' that false if this
+//    method fails. This can only occur if the divisor polynomial is
+//    equal to the scalar value zero. Otherwise the return value is
+//    true.
+//
+//======================================================================
+
+bool Polynomial::DivideInPlace(const Polynomial & divisor_polynomial,
+                               Polynomial & remainder_polynomial)
+{
+    assert(m_degree >= 0);
+    assert(&remainder_polynomial != this);
+
+    if (&divisor_polynomial == this)
+    {
+        Polynomial divisor_copy(divisor_polynomial);
+        return DivideInPlace(divisor_copy, remainder_polynomial);
+    }
+
     //------------------------------------------------------------------
     //  If the divisor is zero then fail.
     //------------------------------------------------------------------
@@ -857,84 +1148,92 @@ bool Polynomial::Divide(const Polynomial & divisor_polynomial,
     bool non_zero_divisor_flag = ((divisor_polynomial.Degree() != 0)
                                      || (divisor_polynomial[0] != 0.0));
 
-    if (non_zero_divisor_flag)
+    if (!non_zero_divisor_flag)
     {
-        //--------------------------------------------------------------
-        //  If this dividend polynomial's degree is not greater than
-        //  or equal to the divisor polynomial's degree then do the division.
-        //--------------------------------------------------------------
+        operator =(DBL_MAX);
+        remainder_polynomial = 0.0;
+        return false;
+    }
 
-        remainder_polynomial = *this;
-        int dividend_degree = Degree();
-        quotient_polynomial = 0.0;
-        int quotient_maximum_degree = dividend_degree - divisor_degree + 1;
-        quotient_polynomial.SetLength(quotient_maximum_degree);
-        quotient_polynomial.m_degree = -1;
-        double * quotient_coefficient_ptr =
-            quotient_polynomial.m_coefficient_vector_ptr;
-        double * dividend_coefficient_ptr =
-            remainder_polynomial.m_coefficient_vector_ptr;
-        double leading_divisor_coefficient = divisor_polynomial[divisor_degree];
+    //------------------------------------------------------------------
+    //  If this dividend polynomial's degree is less than the divisor
+    //  polynomial's degree then the quotient is zero and this
+    //  polynomial is the remainder.
+    //------------------------------------------------------------------
 
-        //--------------------------------------------------------------
-        //  Loop and subtract each scaled divisor polynomial
-        //  to perform the division.
-        //--------------------------------------------------------------
+    int dividend_degree = m_degree;
 
-        int dividend_index = dividend_degree;
+    if (dividend_degree < divisor_degree)
+    {
+        remainder_polynomial = *this;
+        operator =(0.0);
+        return true;
+    }
 
-        for (dividend_index = dividend_degree;
-             dividend_index >= divisor_degree;
-             --dividend_index)
-        {
-            //----------------------------------------------------------
-            //  Subtract the scaled divisor from the dividend.
-            //----------------------------------------------------------
+    //------------------------------------------------------------------
+    //  Loop and subtract each scaled divisor polynomial to perform
+    //  the division. Each quotient coefficient is stored in the
+    //  position of the dividend coefficient that it eliminates, so
+    //  when the loop ends the upper coefficients hold the quotient
+    //  and the lower divisor_degree coefficients hold the remainder.
+    //------------------------------------------------------------------
 
-            double scale_value = remainder_polynomial[dividend_index] / leading_divisor_coefficient;
+    double * dividend_coefficient_ptr = m_coefficient_vector_ptr;
+    const double * divisor_coefficient_ptr = divisor_polynomial.m_coefficient_vector_ptr;
+    double leading_divisor_coefficient = divisor_coefficient_ptr[divisor_degree];
 
-            //----------------------------------------------------------
-            //  Increase the order of the quotient polynomial.
-            //----------------------------------------------------------
+    int dividend_index = dividend_degree;
 
-            quotient_polynomial.m_degree += 1;
-            int j = 0;
+    for (dividend_index = dividend_degree;
+         dividend_index >= divisor_degree;
+         --dividend_index)
+    {
+        double scale_value = dividend_coefficient_ptr[dividend_index] / leading_divisor_coefficient;
+        dividend_coefficient_ptr[dividend_index] = scale_value;
 
-            for (j = quotient_polynomial.m_degree; j >= 1; --j)
-            {
-                quotient_coefficient_ptr[j] = quotient_coefficient_ptr[j - 1];
-            }
+        int offset = dividend_index - divisor_degree;
 
-            quotient_coefficient_ptr[0] = scale_value;
+        for (int j = 0; j < divisor_degree; ++j)
+        {
+            dividend_coefficient_ptr[offset + j] -= divisor_coefficient_ptr[j] * scale_value;
+        }
+    }
 
-            //----------------------------------------------------------
-            //  Subtract the scaled divisor from the dividend.
-            //----------------------------------------------------------
+    //------------------------------------------------------------------
+    //  Store the remainder polynomial.
+    //------------------------------------------------------------------
 
-            int dividend_degree_index = dividend_index;
+    if (divisor_degree == 0)
+    {
+        remainder_polynomial = 0.0;
+    }
+    else
+    {
+        remainder_polynomial.SetLength(divisor_degree, false);
+        remainder_polynomial.m_degree = divisor_degree - 1;
 
-            for (j = divisor_degree; j >=0; --j)
-            {
-                dividend_coefficient_ptr[dividend_degree_index] -= divisor_polynomial[j] * scale_value;
-                --dividend_degree_index;
-            }
+        for (int i = 0; i < divisor_degree; ++i)
+        {
+            remainder_polynomial.m_coefficient_vector_ptr[i] = dividend_coefficient_ptr[i];
         }
 
-        //--------------------------------------------------------------
-        //  Adjust the order of the current dividend polynomial.
-        //  This is the remainder polynomial.
-        //--------------------------------------------------------------
-
         remainder_polynomial.AdjustPolynomialDegree();
-        quotient_polynomial.AdjustPolynomialDegree();
     }
-    else
+
+    //------------------------------------------------------------------
+    //  Move the quotient polynomial down to the lowest powers.
+    //------------------------------------------------------------------
+
+    m_degree = dividend_degree - divisor_degree;
+
+    for (int i = 0; i <= m_degree; ++i)
     {
-        quotient_polynomial = DBL_MAX;
-        remainder_polynomial = 0.0;
+        dividend_coefficient_ptr[i] = dividend_coefficient_ptr[i + divisor_degree];
     }
 
-    return non_zero_divisor_flag;
+    AdjustPolynomialDegree();
+
+    return true;
 }
 
 //======================================================================
@@ -1024,11 +1323,11 @@ double & Polynomial::operator [](int power_index)
 //
 //  Return Value:
 //
-//    This function returns this polynomial.
+//    This function returns a reference to this polynomial.
 //
 //======================================================================
 
-Polynomial Polynomial::operator +=(const Polynomial & polynomial)
+Polynomial & Polynomial::operator +=(const Polynomial & polynomial)
 {
     assert(m_degree >= 0);
 
@@ -1083,11 +1382,11 @@ Polynomial Polynomial::operator +=(const Polynomial & polynomial)
 //
 //  Return Value:
 //
-//    This function returns this polynomial.
+//    This function returns a reference to this polynomial.
 //
 //======================================================================
 
-Polynomial Polynomial::operator +=(double scalar)
+Polynomial & Polynomial::operator +=(double scalar)
 {
     assert(m_degree >= 0);
 
@@ -1111,11 +1410,11 @@ Polynomial Polynomial::operator +=(double scalar)
 //
 //  Return Value:
 //
-//    This function returns this polynomial.
+//    This function returns a reference to this polynomial.
 //
 //======================================================================
 
-Polynomial Polynomial::operator -=(const Polynomial & polynomial)
+Polynomial & Polynomial::operator -=(const Polynomial & polynomial)
 {
     assert(m_degree >= 0);
 
@@ -1170,11 +1469,11 @@ Polynomial Polynomial::operator -=(const Polynomial & polynomial)
 //
 //  Return Value:
 //
-//    This function returns this polynomial.
+//    This function returns a reference to this polynomial.
 //
 //======================================================================
 
-Polynomial Polynomial::operator -=(double scalar)
+Polynomial & Polynomial::operator -=(double scalar)
 {
     assert(m_degree >= 0);
 
@@ -1198,65 +1497,73 @@ Polynomial Polynomial::operator -=(double scalar)
 //
 //  Return Value:
 //
-//    This function returns this polynomial.
+//    This function returns a reference to this polynomial.
 //
 //======================================================================
 
-Polynomial Polynomial::operator *=(const Polynomial & polynomial)
+Polynomial & Polynomial::operator *=(const Polynomial & polynomial)
 {
-    //------------------------------------------------------------------
-    //  Create a temporary buffer to hold the product of the two
-    //  polynomials.
-    //------------------------------------------------------------------
-
     assert(m_degree >= 0);
 
-    int convolution_length = m_degree + polynomial.m_degree + 1;
-
-    std::vector<double> temp_vector;
-    temp_vector.resize(convolution_length + 1);
-    double * temp_vector_ptr = &temp_vector[0];
-
     //------------------------------------------------------------------
-    //  Zero the temporary buffer.
+    //  The product is calculated in place, so multiplying a
+    //  polynomial by itself needs a copy of the multiplier.
     //------------------------------------------------------------------
 
-    int i = 0;
-
-    for (i = 0; i < convolution_length; ++i)
+    if (&polynomial == this)
     {
-        temp_vector_ptr[i] = 0.0;
+        Polynomial multiplier_polynomial(polynomial);
+        return operator *=(multiplier_polynomial);
     }
 
+    int multiplicand_degree = m_degree;
+    int multiplier_degree = polynomial.m_degree;
+    int product_degree = multiplicand_degree + multiplier_degree;
+
     //------------------------------------------------------------------
-    //  Calculate the convolution in the temporary buffer.
+    //  High degree products are calculated with the FFT.
     //------------------------------------------------------------------
 
-    for (i = 0; i <= m_degree; ++i)
+    int threshold = fft_multiplication_threshold.load(std::memory_order_relaxed);
+
+    if ((multiplicand_degree >= threshold) && (multiplier_degree >= threshold))
     {
-        for (int j = 0; j <= polynomial.m_degree; ++j)
-        {
-            temp_vector_ptr[i + j] += m_coefficient_vector_ptr[i] * polynomial.m_coefficient_vector_ptr[j];
-        }
+        MultiplyUsingFft(polynomial);
+        return *this;
     }
 
     //------------------------------------------------------------------
-    //  Make sure this buffer is large enough for the product.
+    //  Make sure this buffer is large enough for the product. The
+    //  existing buffer is reused if it is large enough.
     //------------------------------------------------------------------
 
-    SetLength((unsigned int)(convolution_length), false);
+    SetLength((unsigned int)(product_degree + 1), true);
 
     //------------------------------------------------------------------
-    //  Store the result in this instance.
+    //  Calculate the convolution from the highest power down. Output
+    //  coefficient k only depends on input coefficients with an index
+    //  less than or equal to k, so it can overwrite input coefficient k.
     //------------------------------------------------------------------
 
-    m_degree = convolution_length - 1;
+    double * product_ptr = m_coefficient_vector_ptr;
+    const double * multiplier_ptr = polynomial.m_coefficient_vector_ptr;
 
-    for (i = 0; i <= m_degree; ++i)
+    for (int k = product_degree; k >= 0; --k)
     {
-        m_coefficient_vector_ptr[i] = temp_vector_ptr[i];
+        int first_index = (k > multiplier_degree) ? (k - multiplier_degree) : 0;
+        int last_index = (k < multiplicand_degree) ? k : multiplicand_degree;
+        double sum = 0.0;
+
+        for (int i = first_index; i <= last_index; ++i)
+        {
+            sum += product_ptr[i] * multiplier_ptr[k - i];
+        }
+
+        product_ptr[k] = sum;
     }
 
+    m_degree = product_degree;
+
     //------------------------------------------------------------------
     //  If the leading coefficient(s) are zero, then decrease the
     //  polynomial degree.
@@ -1282,11 +1589,11 @@ Polynomial Polynomial::operator *=(const Polynomial & polynomial)
 //
 //  Return Value:
 //
-//    This function returns this polynomial.
+//    This function returns a reference to this polynomial.
 //
 //======================================================================
 
-Polynomial Polynomial::operator *=(double scalar)
+Polynomial & Polynomial::operator *=(double scalar)
 {
     assert(m_degree >= 0);
 
@@ -1322,11 +1629,11 @@ Polynomial Polynomial::operator *=(double scalar)
 //
 //  Return Value:
 //
-//    This function returns this polynomial.
+//    This function returns a reference to this polynomial.
 //
 //======================================================================
 
-Polynomial Polynomial::operator /=(double scalar)
+Polynomial & Polynomial::operator /=(double scalar)
 {
     assert(m_degree >= 0);
 
@@ -1414,11 +1721,11 @@ Polynomial Polynomial::operator -()
 //
 //  Return Value:
 //
-//    This function returns this polynomial.
+//    This function returns a reference to this polynomial.
 //
 //======================================================================
 
-Polynomial Polynomial::operator =(double scalar)
+Polynomial & Polynomial::operator =(double scalar)
 {
     SetCoefficients(&scalar, 0);
     return *this;
@@ -1439,11 +1746,11 @@ Polynomial Polynomial::operator =(double scalar)
 //
 //  Return Value:
 //
-//    This function returns this polynomial.
+//    This function returns a reference to this polynomial.
 //
 //======================================================================
 
-Polynomial Polynomial::operator =(const Polynomial & polynomial)
+Polynomial & Polynomial::operator =(const Polynomial & polynomial)
 {
     if (this != &polynomial)
     {
@@ -1453,6 +1760,37 @@ Polynomial Polynomial::operator =(const Polynomial & polynomial)
     return *this;
 }
 
+//======================================================================
+//  Member Function: Polynomial::operator =
+//
+//  Abstract:
+//
+//    This method takes over the coefficients of the passed
+//    polynomial. The passed polynomial is left without coefficients
+//    and must be assigned to before it is used again.
+//
+//
+//  Input:
+//
+//    polynomial    An instance of class Polynomial
+//
+//
+//  Return Value:
+//
+//    This function returns a reference to this polynomial.
+//
+//======================================================================
+
+Polynomial & Polynomial::operator =(Polynomial && polynomial) noexcept
+{
+    if (this != &polynomial)
+    {
+        Move(polynomial);
+    }
+
+    return *this;
+}
+
 //======================================================================
 //  Member Function: Polynomial::AdjustPolynomialDegree
 //
@@ -1490,6 +1828,119 @@ void Polynomial::AdjustPolynomialDegree()
     return;
 }
 
+//======================================================================
+//  Member Function: Polynomial::MultiplyUsingFft
+//
+//  Abstract:
+//
+//    This method multiplies a polynomial times this polynomial using
+//    the FFT. Both real coefficient sequences are packed into one
+//    complex sequence a + i * b. Squaring its transform gives the
+//    transform of a * a - b * b + 2 * i * a * b, so half the imaginary
+//    part of the inverse transform is the product. The multiplier is
+//    scaled to the same magnitude as this polynomial first so that
+//    neither sequence is lost in the rounding error of the other.
+//
+//
+//  Input:
+//
+//    polynomial    An instance of class Polynomial
+//
+//
+//  Return Value:
+//
+//    This method has no return value.
+//
+//======================================================================
+
+void Polynomial::MultiplyUsingFft(const Polynomial & polynomial)
+{
+    int product_degree = m_degree + polynomial.m_degree;
+
+    size_t transform_length = 1;
+
+    while (transform_length < (size_t)(product_degree + 1))
+    {
+        transform_length <<= 1;
+    }
+
+    //------------------------------------------------------------------
+    //  Find the scale factor for the multiplier.
+    //------------------------------------------------------------------
+
+    double multiplicand_maximum = 0.0;
+    double multiplier_maximum = 0.0;
+
+    int i = 0;
+
+    for (i = 0; i <= m_degree; ++i)
+    {
+        multiplicand_maximum = std::max(multiplicand_maximum, fabs(m_coefficient_vector_ptr[i]));
+    }
+
+    for (i = 0; i <= polynomial.m_degree; ++i)
+    {
+        multiplier_maximum = std::max(multiplier_maximum, fabs(polynomial.m_coefficient_vector_ptr[i]));
+    }
+
+    if ((multiplicand_maximum == 0.0) || (multiplier_maximum == 0.0))
+    {
+        operator =(0.0);
+        return;
+    }
+
+    double scale = multiplicand_maximum / multiplier_maximum;
+
+    //------------------------------------------------------------------
+    //  Pack, transform, square and transform back.
+    //------------------------------------------------------------------
+
+    std::vector<std::complex<double> > data_vector(transform_length);
+
+    for (i = 0; i <= m_degree; ++i)
+    {
+        data_vector[i].real(m_coefficient_vector_ptr[i]);
+    }
+
+    for (i = 0; i <= polynomial.m_degree; ++i)
+    {
+        data_vector[i].imag(polynomial.m_coefficient_vector_ptr[i] * scale);
+    }
+
+    TransformInPlace(data_vector, false);
+
+    for (size_t k = 0; k < transform_length; ++k)
+    {
+        data_vector[k] *= data_vector[k];
+    }
+
+    TransformInPlace(data_vector, true);
+
+    //------------------------------------------------------------------
+    //  Store the result in this instance.
+    //------------------------------------------------------------------
+
+    SetLength((unsigned int)(product_degree + 1), false);
+
+    m_degree = product_degree;
+
+    double unscale = 0.5 / scale;
+
+    for (i = 0; i <= m_degree; ++i)
+    {
+        m_coefficient_vector_ptr[i] = data_vector[i].imag() * unscale;
+    }
+
+    //------------------------------------------------------------------
+    //  If the leading coefficient(s) are zero, then decrease the
+    //  polynomial degree.
+    //------------------------------------------------------------------
+
+    AdjustPolynomialDegree();
+
+    return;
+}
+
 //======================================================================
 //  Member Function: Polynomial::Copy
 //
@@ -1505,13 +1956,13 @@ void Polynomial::AdjustPolynomialDegree()
 //
 //  Return Value:
 //
-//    This function returns this polynomial.
+//    This function returns a reference to this polynomial.
 //
 //======================================================================
 
 void Polynomial::Copy(const Polynomial & polynomial)
 {
-    SetLength(polynomial.m_degree + 1);
+    SetLength(polynomial.m_degree + 1, false);
 
     m_degree = polynomial.m_degree;
 
@@ -1523,6 +1974,69 @@ void Polynomial::Copy(const Polynomial & polynomial)
     return;
 }
 
+//======================================================================
+//  Member Function: Polynomial::Move
+//
+//  Abstract:
+//
+//    This method moves the coefficients of a passed polynomial into
+//    this instance. Inline coefficients are copied. A heap buffer is
+//    swapped with this instance's heap buffer, so neither buffer is
+//    freed. The passed polynomial is left without coefficients.
+//
+//
+//  Input:
+//
+//    polynomial    An instance of class Polynomial.
+//
+//
+//  Return Value:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void Polynomial::Move(Polynomial & polynomial)
+{
+    if ((polynomial.m_coefficient_vector_ptr == NULL)
+        || (polynomial.UsesInlineStorage()))
+    {
+        m_coefficient_vector_ptr = &m_inline_coefficient_array[0];
+
+        for (int i = 0; i <= polynomial.m_degree; ++i)
+        {
+            m_coefficient_vector_ptr[i] = polynomial.m_coefficient_vector_ptr[i];
+        }
+    }
+    else
+    {
+        m_coefficient_vector.swap(polynomial.m_coefficient_vector);
+        m_coefficient_vector_ptr = &m_coefficient_vector[0];
+    }
+
+    m_degree = polynomial.m_degree;
+
+    polynomial.m_degree = -1;
+    polynomial.m_coefficient_vector_ptr = NULL;
+
+    return;
+}
+
+//======================================================================
+//  Member Function: Polynomial::UsesInlineStorage
+//
+//  Abstract:
+//
+//    This method returns true if the coefficients are stored in
+//    m_inline_coefficient_array rather than in m_coefficient_vector.
+//
+//======================================================================
+
+bool Polynomial::UsesInlineStorage() const
+{
+    return m_coefficient_vector_ptr == &m_inline_coefficient_array[0];
+}
+
 //======================================================================
 //  Member Function: Polynomial::SetLength
 //
@@ -1536,7 +2050,9 @@ void Polynomial::Copy(const Polynomial & polynomial)
 //    buffer lengths then the buffer is reallocated to the new
 //    buffer size. In this case, if argument copy_data_flag
 //    is set to the value true then the data in the old buffer
-//    is copied to the new buffer.
+//    is copied to the new buffer. Lengths of up to
+//    MAXIMUM_INLINE_DEGREE + 1 use the inline buffer and never
+//    allocate.
 //
 //
 //  Input:
@@ -1557,55 +2073,61 @@ void Polynomial::Copy(const Polynomial & polynomial)
 void Polynomial::SetLength(unsigned int number_of_coefficients,
                            bool copy_data_flag)
 {
-
     // If m_degree is equal to -1, then this is a new polynomial and the
-    // caller will set m_degree.
-    if ((!copy_data_flag) || (m_degree == -1))
+    // caller will set m_degree. If the data is not copied then the
+    // caller overwrites all coefficients.
+    int old_degree = m_degree;
+    bool keep_data_flag = (copy_data_flag) && (old_degree != -1);
+
+    int number_to_keep = 0;
+
+    if (keep_data_flag)
     {
-        // Clear and resize the coefficient vector.
-        m_coefficient_vector.clear();
-        m_coefficient_vector.resize(number_of_coefficients);
-        m_coefficient_vector_ptr = &m_coefficient_vector[0];
+        number_to_keep = ((unsigned int)(old_degree + 1) < number_of_coefficients)
+            ? old_degree + 1
+            : (int)(number_of_coefficients);
     }
-    else
-    {
-        // Save the polynomial values in a temporary vector.
-        std::vector<double> temp_vector;
-        temp_vector.resize(m_degree + 1);
 
-        int i = 0;
+    bool was_on_heap_flag = (m_coefficient_vector_ptr != NULL) && (!UsesInlineStorage());
 
-        for (i = 0; i <= m_degree; ++i)
+    if (number_of_coefficients <= (unsigned int)(MAXIMUM_INLINE_DEGREE + 1))
+    {
+        // The coefficients fit in the inline buffer. The heap buffer,
+        // if any, keeps its capacity in case the polynomial grows again.
+        if (was_on_heap_flag)
         {
-            temp_vector[i] = m_coefficient_vector_ptr[i];
+            for (int i = 0; i < number_to_keep; ++i)
+            {
+                m_inline_coefficient_array[i] = m_coefficient_vector[i];
+            }
         }
 
-        // Clear and resize the coefficient vector.
-        m_coefficient_vector.clear();
+        m_coefficient_vector_ptr = &m_inline_coefficient_array[0];
+    }
+    else
+    {
+        // Resizing the coefficient vector keeps its capacity, so the
+        // buffer is only reallocated when the polynomial grows beyond
+        // any length it had before.
         m_coefficient_vector.resize(number_of_coefficients);
-        m_coefficient_vector_ptr = &m_coefficient_vector[0];
 
-        // Restore the coefficients for the new vector size.
-        // Was the polynomial size increased?
-        if (number_of_coefficients > (unsigned int)(m_degree + 1))
+        if (!was_on_heap_flag)
         {
-            // The polynomial size was increased.
-            for (i = 0; i <= m_degree; ++i)
+            for (int i = 0; i < number_to_keep; ++i)
             {
-                m_coefficient_vector_ptr[i] = temp_vector[i];
-            }
-
-            for (i = m_degree + 1; i < (int)(number_of_coefficients); ++i)
-            {
-                m_coefficient_vector_ptr[i] = 0.0;
+                m_coefficient_vector[i] = m_inline_coefficient_array[i];
             }
         }
-        else
+
+        m_coefficient_vector_ptr = &m_coefficient_vector[0];
+    }
+
+    if (keep_data_flag)
+    {
+        // Zero the coefficients above the current degree.
+        for (int i = old_degree + 1; i < (int)(number_of_coefficients); ++i)
         {
-            for (int i = 0; i < (int)(number_of_coefficients); ++i)
-            {
-                m_coefficient_vector_ptr[i] = temp_vector[i];
-            }
+            m_coefficient_vector_ptr[i] = 0.0;
         }
     }
 
@@ -1614,6 +2136,10 @@ void Polynomial::SetLength(unsigned int number_of_coefficients,
 
 //======================================================================
 //  Global operators
+//
+//  The result is built in a named local so that it is returned
+//  without a copy. The overloads that take an rvalue reference
+//  reuse the coefficient buffer of the temporary operand.
 //======================================================================
 
 //======================================================================
@@ -1623,7 +2149,17 @@ void Polynomial::SetLength(unsigned int number_of_coefficients,
 Polynomial operator +(const Polynomial & polynomial_0,
                       const Polynomial & polynomial_1)
 {
-    return Polynomial(polynomial_0) += polynomial_1;
+    Polynomial result(polynomial_0);
+    result += polynomial_1;
+    return result;
+}
+
+Polynomial operator +(Polynomial && polynomial_0,
+                      const Polynomial & polynomial_1)
+{
+    Polynomial result(std::move(polynomial_0));
+    result += polynomial_1;
+    return result;
 }
 
 //======================================================================
@@ -1633,13 +2169,17 @@ Polynomial operator +(const Polynomial & polynomial_0,
 Polynomial operator +(const Polynomial & polynomial,
                       double scalar)
 {
-    return Polynomial(polynomial) += scalar;
+    Polynomial result(polynomial);
+    result += scalar;
+    return result;
 }
 
 Polynomial operator +(double scalar,
                       const Polynomial & polynomial)
 {
-    return Polynomial(polynomial) += scalar;
+    Polynomial result(polynomial);
+    result += scalar;
+    return result;
 }
 
 //======================================================================
@@ -1649,7 +2189,17 @@ Polynomial operator +(double scalar,
 Polynomial operator -(const Polynomial & minuend_polynomial,
                       const Polynomial & subtrahend_polynomial)
 {
-    return Polynomial(minuend_polynomial) -= subtrahend_polynomial;
+    Polynomial result(minuend_polynomial);
+    result -= subtrahend_polynomial;
+    return result;
+}
+
+Polynomial operator -(Polynomial && minuend_polynomial,
+                      const Polynomial & subtrahend_polynomial)
+{
+    Polynomial result(std::move(minuend_polynomial));
+    result -= subtrahend_polynomial;
+    return result;
 }
 
 //======================================================================
@@ -1659,13 +2209,18 @@ Polynomial operator -(const Polynomial & minuend_polynomial,
 Polynomial operator -(const Polynomial & minuend_polynomial,
                       double scalar)
 {
-    return Polynomial(minuend_polynomial) -= scalar;
+    Polynomial result(minuend_polynomial);
+    result -= scalar;
+    return result;
 }
 
 Polynomial operator -(double scalar,
                       const Polynomial & polynomial)
 {
-    return (-Polynomial(polynomial)) + scalar;
+    Polynomial result(polynomial);
+    result *= -1.0;
+    result += scalar;
+    return result;
 }
 
 //======================================================================
@@ -1675,7 +2230,17 @@ Polynomial operator -(double scalar,
 Polynomial operator *(const Polynomial & polynomial_0,
                       const Polynomial & polynomial_1)
 {
-    return Polynomial(polynomial_0) *= polynomial_1;
+    Polynomial result(polynomial_0);
+    result *= polynomial_1;
+    return result;
+}
+
+Polynomial operator *(Polynomial && polynomial_0,
+                      const Polynomial & polynomial_1)
+{
+    Polynomial result(std::move(polynomial_0));
+    result *= polynomial_1;
+    return result;
 }
 
 //======================================================================
@@ -1685,13 +2250,17 @@ Polynomial operator *(const Polynomial & polynomial_0,
 Polynomial operator *(const Polynomial & polynomial,
                       double scalar)
 {
-    return Polynomial(polynomial) *= scalar;
+    Polynomial result(polynomial);
+    result *= scalar;
+    return result;
 }
 
 Polynomial operator *(double scalar,
                       const Polynomial & polynomial)
 {
-    return Polynomial(polynomial) *= scalar;
+    Polynomial result(polynomial);
+    result *= scalar;
+    return result;
 }
 
 //======================================================================
@@ -1701,5 +2270,7 @@ Polynomial operator *(double scalar,
 Polynomial operator /(const Polynomial & polynomial,
                       double scalar)
 {
-    return Polynomial(polynomial) /= scalar;
+    Polynomial result(polynomial);
+    result /= scalar;
+    return result;
 }
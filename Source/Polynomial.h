@@ -47,6 +47,16 @@ class Polynomial
 {
 protected:
 
+    //------------------------------------------------------------------
+    //  Polynomials up to this degree keep their coefficients in
+    //  m_inline_coefficient_array. Higher degree polynomials use
+    //  m_coefficient_vector. m_coefficient_vector_ptr points to
+    //  whichever buffer is in use.
+    //------------------------------------------------------------------
+
+    enum { MAXIMUM_INLINE_DEGREE = 8 };
+
+    double m_inline_coefficient_array[MAXIMUM_INLINE_DEGREE + 1];
     std::vector<double> m_coefficient_vector;
     int m_degree;
     double * m_coefficient_vector_ptr;
@@ -67,6 +77,8 @@ public:
 
     Polynomial(const Polynomial & polynomial);
 
+    Polynomial(Polynomial && polynomial) noexcept;
+
     virtual ~Polynomial();
 
     void SetCoefficients(double * coefficient_vector_ptr,
@@ -118,38 +130,57 @@ public:
                 Polynomial & quotient_polynomial,
                 Polynomial & remainder_polynomial) const;
 
+    bool DivideInPlace(const Polynomial & divisor_polynomial,
+                       Polynomial & remainder_polynomial);
+
     double operator [](int power_index) const;
 
     double & operator [](int power_index);
 
-    Polynomial operator +=(const Polynomial & polynomial);
+    Polynomial & operator +=(const Polynomial & polynomial);
 
-    Polynomial operator +=(double scalar);
+    Polynomial & operator +=(double scalar);
 
-    Polynomial operator -=(const Polynomial & polynomial);
+    Polynomial & operator -=(const Polynomial & polynomial);
 
-    Polynomial operator -=(double scalar);
+    Polynomial & operator -=(double scalar);
 
-    Polynomial operator *=(const Polynomial & polynomial);
+    Polynomial & operator *=(const Polynomial & polynomial);
 
-    Polynomial operator *=(double scalar);
+    Polynomial & operator *=(double scalar);
 
-    Polynomial operator /=(double scalar);
+    Polynomial & operator /=(double scalar);
 
     Polynomial operator +();
 
     Polynomial operator -();
 
-    Polynomial operator =(double scalar);
+    Polynomial & operator =(double scalar);
+
+    Polynomial & operator =(const Polynomial & polynomial);
 
-    Polynomial operator =(const Polynomial & polynomial);
+    Polynomial & operator =(Polynomial && polynomial) noexcept;
+
+    static Polynomial FromRoots(const double * real_zero_vector_ptr,
+                                const double * imaginary_zero_vector_ptr,
+                                int number_of_roots);
+
+    static void SetFftMultiplicationThreshold(int degree);
+
+    static int GetFftMultiplicationThreshold();
 
 private:
 
     void AdjustPolynomialDegree();
 
+    void MultiplyUsingFft(const Polynomial & polynomial);
+
     void Copy(const Polynomial & polynomial);
 
+    void Move(Polynomial & polynomial);
+
+    bool UsesInlineStorage() const;
+
     void SetLength(unsigned int number_of_coefficients,
                    bool copy_data_flag = true);
 };
@@ -165,6 +196,9 @@ private:
 Polynomial operator +(const Polynomial & polynomial_0,
                       const Polynomial & polynomial_1);
 
+Polynomial operator +(Polynomial && polynomial_0,
+                      const Polynomial & polynomial_1);
+
 //======================================================================
 //  Addition of an instance of the Polynomial class and a scalar.
 //======================================================================
@@ -182,6 +216,9 @@ Polynomial operator +(double scalar,
 Polynomial operator -(const Polynomial & minuend_polynomial,
                       const Polynomial & subtrahend_polynomial);
 
+Polynomial operator -(Polynomial && minuend_polynomial,
+                      const Polynomial & subtrahend_polynomial);
+
 //======================================================================
 //  Subtraction with an instance of the Polynomial class and a scalar.
 //======================================================================
@@ -199,6 +236,9 @@ Polynomial operator -(double scalar,
 Polynomial operator *(const Polynomial & polynomial_0,
                       const Polynomial & polynomial_1);
 
+Polynomial operator *(Polynomial && polynomial_0,
+                      const Polynomial & polynomial_1);
+
 //======================================================================
 //  Multiplication of an instance of the Polynomial class and a scalar.
 //======================================================================
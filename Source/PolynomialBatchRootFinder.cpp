@@ -0,0 +1,418 @@
+//**********************************************************************
+//  File: PolynomialBatchRootFinder.cpp
+//
+//  Abstract:
+//
+//    This file contains the implementation for class
+//    PolynomialBatchRootFinder.
+//
+//**********************************************************************
+
+#include <math.h>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include "PolynomialBatchRootFinder.h"
+
+//======================================================================
+//  Local constants.
+//======================================================================
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  Batches with fewer polynomials per thread than this are not
+    //  worth the cost of starting a thread.
+    //------------------------------------------------------------------
+
+    const int i_MINIMUM_POLYNOMIALS_PER_THREAD = 256;
+};
+
+//======================================================================
+//  Member Function: PolynomialBatchRootFinder::FindRoots
+//
+//  Abstract:
+//
+//    This method determines the roots of a block of polynomials
+//    of the same degree. The block is split into contiguous ranges
+//    that are solved on separate threads. Every thread uses its own
+//    instance of class PolynomialRootFinder and writes to disjoint
+//    parts of the output blocks, so no mutable state is shared.
+//
+//    First and second order polynomials are solved in closed form
+//    with loops that run over the polynomial index so that the
+//    compiler can map them onto SIMD lanes.
+//
+//
+//  Input:
+//
+//    coefficient_block_ptr      A block of (degree + 1) * number_of_polynomials
+//                               coefficients. Coefficient 'k' of
+//                               polynomial 'i' is at index
+//                               k * number_of_polynomials + i.
+//
+//    degree                     The degree of every polynomial.
+//
+//    number_of_polynomials      The number of polynomials in the block.
+//
+//    real_zero_block_ptr        A block of degree * number_of_polynomials
+//                               values that will contain the real parts
+//                               of the roots. Root 'r' of polynomial 'i'
+//                               is at index r * number_of_polynomials + i.
+//
+//    imaginary_zero_block_ptr   A block with the same layout that will
+//                               contain the imaginary parts of the roots.
+//
+//    status_vector_ptr          A vector of number_of_polynomials values
+//                               that will contain the status for each
+//                               polynomial.
+//
+//    roots_found_vector_ptr     An optional vector of number_of_polynomials
+//                               values that will contain the number of
+//                               roots found for each polynomial.
+//
+//    number_of_threads          The number of threads to use. If this is
+//                               zero then the hardware concurrency is used.
+//
+//  Return Value:
+//
+//    The function has no return value.
+//
+//======================================================================
+
+void PolynomialBatchRootFinder::FindRoots(const double * coefficient_block_ptr,
+                                          int degree,
+                                          int number_of_polynomials,
+                                          double * real_zero_block_ptr,
+                                          double * imaginary_zero_block_ptr,
+                                          PolynomialRootFinder::RootStatus_T * status_vector_ptr,
+                                          int * roots_found_vector_ptr,
+                                          int number_of_threads)
+{
+    if (number_of_polynomials <= 0)
+    {
+        return;
+    }
+
+    if (number_of_threads <= 0)
+    {
+        number_of_threads = (int)(std::thread::hardware_concurrency());
+    }
+
+    int maximum_threads = number_of_polynomials / i_MINIMUM_POLYNOMIALS_PER_THREAD;
+    number_of_threads = std::max(1, std::min(number_of_threads, maximum_threads));
+
+    //------------------------------------------------------------------
+    //  Solve small batches on the calling thread.
+    //------------------------------------------------------------------
+
+    if (number_of_threads == 1)
+    {
+        FindRootsInRange(coefficient_block_ptr,
+                         degree,
+                         number_of_polynomials,
+                         0,
+                         number_of_polynomials,
+                         real_zero_block_ptr,
+                         imaginary_zero_block_ptr,
+                         status_vector_ptr,
+                         roots_found_vector_ptr);
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Split the block into contiguous ranges. The calling thread
+    //  solves the last range itself.
+    //------------------------------------------------------------------
+
+    std::vector<std::thread> thread_vector;
+    thread_vector.reserve(number_of_threads - 1);
+
+    int range_length = (number_of_polynomials + number_of_threads - 1) / number_of_threads;
+    int first_index = 0;
+
+    for (int t = 0; t < number_of_threads - 1; ++t)
+    {
+        int end_index = std::min(first_index + range_length, number_of_polynomials);
+
+        thread_vector.push_back(std::thread(&PolynomialBatchRootFinder::FindRootsInRange,
+                                            coefficient_block_ptr,
+                                            degree,
+                                            number_of_polynomials,
+                                            first_index,
+                                            end_index,
+                                            real_zero_block_ptr,
+                                            imaginary_zero_block_ptr,
+                                            status_vector_ptr,
+                                            roots_found_vector_ptr));
+        first_index = end_index;
+    }
+
+    FindRootsInRange(coefficient_block_ptr,
+                     degree,
+                     number_of_polynomials,
+                     first_index,
+                     number_of_polynomials,
+                     real_zero_block_ptr,
+                     imaginary_zero_block_ptr,
+                     status_vector_ptr,
+                     roots_found_vector_ptr);
+
+    for (size_t t = 0; t < thread_vector.size(); ++t)
+    {
+        thread_vector[t].join();
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: PolynomialBatchRootFinder::FindRootsInRange
+//
+//  Abstract:
+//
+//    This method solves the polynomials with an index in the range
+//    [first_index, end_index). The arguments are the same as for
+//    method FindRoots.
+//
+//======================================================================
+
+void PolynomialBatchRootFinder::FindRootsInRange(const double * coefficient_block_ptr,
+                                                 int degree,
+                                                 int number_of_polynomials,
+                                                 int first_index,
+                                                 int end_index,
+                                                 double * real_zero_block_ptr,
+                                                 double * imaginary_zero_block_ptr,
+                                                 PolynomialRootFinder::RootStatus_T * status_vector_ptr,
+                                                 int * roots_found_vector_ptr)
+{
+    int i = 0;
+
+    if (degree <= 0)
+    {
+        for (i = first_index; i < end_index; ++i)
+        {
+            status_vector_ptr[i] = PolynomialRootFinder::SCALAR_VALUE_HAS_NO_ROOTS;
+
+            if (roots_found_vector_ptr != 0)
+            {
+                roots_found_vector_ptr[i] = 0;
+            }
+        }
+    }
+    else if (degree == 1)
+    {
+        FindLinearRoots(coefficient_block_ptr,
+                        number_of_polynomials,
+                        first_index,
+                        end_index,
+                        real_zero_block_ptr,
+                        imaginary_zero_block_ptr,
+                        status_vector_ptr,
+                        roots_found_vector_ptr);
+    }
+    else if (degree == 2)
+    {
+        FindQuadraticRoots(coefficient_block_ptr,
+                           number_of_polynomials,
+                           first_index,
+                           end_index,
+                           real_zero_block_ptr,
+                           imaginary_zero_block_ptr,
+                           status_vector_ptr,
+                           roots_found_vector_ptr);
+    }
+    else
+    {
+        //--------------------------------------------------------------
+        //  Gather each polynomial into a contiguous buffer, solve it
+        //  with this thread's root finder and scatter the roots back.
+        //--------------------------------------------------------------
+
+        PolynomialRootFinder root_finder;
+
+        std::vector<double> coefficient_vector;
+        std::vector<double> real_zero_vector;
+        std::vector<double> imaginary_zero_vector;
+        coefficient_vector.resize(degree + 1);
+        real_zero_vector.resize(degree + 1);
+        imaginary_zero_vector.resize(degree + 1);
+
+        for (i = first_index; i < end_index; ++i)
+        {
+            int k = 0;
+
+            for (k = 0; k <= degree; ++k)
+            {
+                coefficient_vector[k] = coefficient_block_ptr[k * number_of_polynomials + i];
+            }
+
+            int roots_found = 0;
+
+            status_vector_ptr[i] = root_finder.FindRoots(&coefficient_vector[0],
+                                                         degree,
+                                                         &real_zero_vector[0],
+                                                         &imaginary_zero_vector[0],
+                                                         &roots_found);
+
+            for (k = 0; k < degree; ++k)
+            {
+                real_zero_block_ptr[k * number_of_polynomials + i] = real_zero_vector[k];
+                imaginary_zero_block_ptr[k * number_of_polynomials + i] = imaginary_zero_vector[k];
+            }
+
+            if (roots_found_vector_ptr != 0)
+            {
+                roots_found_vector_ptr[i] = roots_found;
+            }
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: PolynomialBatchRootFinder::FindLinearRoots
+//
+//  Abstract:
+//
+//    This method solves c1 * x + c0 = 0 for every polynomial in the
+//    range [first_index, end_index).
+//
+//======================================================================
+
+void PolynomialBatchRootFinder::FindLinearRoots(const double * coefficient_block_ptr,
+                                                int number_of_polynomials,
+                                                int first_index,
+                                                int end_index,
+                                                double * real_zero_block_ptr,
+                                                double * imaginary_zero_block_ptr,
+                                                PolynomialRootFinder::RootStatus_T * status_vector_ptr,
+                                                int * roots_found_vector_ptr)
+{
+    const double * c0_ptr = coefficient_block_ptr;
+    const double * c1_ptr = coefficient_block_ptr + number_of_polynomials;
+
+    int i = 0;
+
+    for (i = first_index; i < end_index; ++i)
+    {
+        double c1 = (c1_ptr[i] == 0.0) ? 1.0 : c1_ptr[i];
+        real_zero_block_ptr[i] = - c0_ptr[i] / c1;
+        imaginary_zero_block_ptr[i] = 0.0;
+    }
+
+    for (i = first_index; i < end_index; ++i)
+    {
+        bool valid_flag = (c1_ptr[i] != 0.0);
+
+        status_vector_ptr[i] = valid_flag ? PolynomialRootFinder::SUCCESS
+                                          : PolynomialRootFinder::LEADING_COEFFICIENT_IS_ZERO;
+
+        if (roots_found_vector_ptr != 0)
+        {
+            roots_found_vector_ptr[i] = valid_flag ? 1 : 0;
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: PolynomialBatchRootFinder::FindQuadraticRoots
+//
+//  Abstract:
+//
+//    This method solves c2 * x^2 + c1 * x + c0 = 0 for every
+//    polynomial in the range [first_index, end_index).
+//
+//    The first loop has no data dependent branches so that it can be
+//    vectorized. The larger real root is found with the quadratic
+//    formula and the smaller real root from the product of the roots
+//    c0 / c2, as in PolynomialRootFinder::SolveQuadraticEquation.
+//    The few lanes that the first loop cannot handle are fixed up
+//    in a second, scalar loop.
+//
+//======================================================================
+
+void PolynomialBatchRootFinder::FindQuadraticRoots(const double * coefficient_block_ptr,
+                                                   int number_of_polynomials,
+                                                   int first_index,
+                                                   int end_index,
+                                                   double * real_zero_block_ptr,
+                                                   double * imaginary_zero_block_ptr,
+                                                   PolynomialRootFinder::RootStatus_T * status_vector_ptr,
+                                                   int * roots_found_vector_ptr)
+{
+    const double * c0_ptr = coefficient_block_ptr;
+    const double * c1_ptr = coefficient_block_ptr + number_of_polynomials;
+    const double * c2_ptr = coefficient_block_ptr + 2 * number_of_polynomials;
+
+    double * sr_ptr = real_zero_block_ptr;
+    double * si_ptr = imaginary_zero_block_ptr;
+    double * lr_ptr = real_zero_block_ptr + number_of_polynomials;
+    double * li_ptr = imaginary_zero_block_ptr + number_of_polynomials;
+
+    int i = 0;
+
+    for (i = first_index; i < end_index; ++i)
+    {
+        double a = (c2_ptr[i] == 0.0) ? 1.0 : c2_ptr[i];
+        double b = c1_ptr[i];
+        double c = c0_ptr[i];
+
+        double discriminant = b * b - 4.0 * a * c;
+        double root = ::sqrt(::fabs(discriminant));
+        bool real_flag = (discriminant >= 0.0);
+
+        //--------------------------------------------------------------
+        //  Real zeros.
+        //--------------------------------------------------------------
+
+        double q = -0.5 * (b + ((b >= 0.0) ? root : - root));
+        double q_divisor = (q == 0.0) ? 1.0 : q;
+        double large_real = q / a;
+        double small_real = c / q_divisor;
+
+        //--------------------------------------------------------------
+        //  Complex conjugate zeros.
+        //--------------------------------------------------------------
+
+        double complex_real = -0.5 * b / a;
+        double complex_imag = ::fabs(0.5 * root / a);
+
+        sr_ptr[i] = real_flag ? small_real : complex_real;
+        si_ptr[i] = real_flag ? 0.0 : complex_imag;
+        lr_ptr[i] = real_flag ? large_real : complex_real;
+        li_ptr[i] = real_flag ? 0.0 : - complex_imag;
+    }
+
+    for (i = first_index; i < end_index; ++i)
+    {
+        PolynomialRootFinder::RootStatus_T status = PolynomialRootFinder::SUCCESS;
+
+        if (c2_ptr[i] == 0.0)
+        {
+            status = PolynomialRootFinder::LEADING_COEFFICIENT_IS_ZERO;
+        }
+        else if ((c1_ptr[i] == 0.0) && (c0_ptr[i] == 0.0))
+        {
+            //----------------------------------------------------------
+            //  A double root at the origin.
+            //----------------------------------------------------------
+
+            sr_ptr[i] = 0.0;
+            lr_ptr[i] = 0.0;
+        }
+
+        status_vector_ptr[i] = status;
+
+        if (roots_found_vector_ptr != 0)
+        {
+            roots_found_vector_ptr[i] = (status == PolynomialRootFinder::SUCCESS) ? 2 : 0;
+        }
+    }
+
+    return;
+}
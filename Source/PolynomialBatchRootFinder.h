@@ -0,0 +1,76 @@
+//**********************************************************************
+//  File: PolynomialBatchRootFinder.h
+//
+//  Abstract:
+//
+//    This file contains the definition for class
+//    PolynomialBatchRootFinder.
+//
+//    The batch root finder solves a block of polynomials that all
+//    have the same degree. The coefficients are passed as a
+//    structure of arrays, i.e. coefficient 'k' of polynomial 'i'
+//    is stored at index k * number_of_polynomials + i. The roots
+//    are returned in the same layout.
+//
+//**********************************************************************
+
+#ifndef POLYNOMIALBATCHROOTFINDER_H
+#define POLYNOMIALBATCHROOTFINDER_H
+
+#include "PolynomialRootFinder.h"
+
+//======================================================================
+//  Class definition.
+//======================================================================
+
+class PolynomialBatchRootFinder
+{
+public:
+
+    static void FindRoots(const double * coefficient_block_ptr,
+                          int degree,
+                          int number_of_polynomials,
+                          double * real_zero_block_ptr,
+                          double * imaginary_zero_block_ptr,
+                          PolynomialRootFinder::RootStatus_T * status_vector_ptr,
+                          int * roots_found_vector_ptr = 0,
+                          int number_of_threads = 0);
+
+private:
+
+    static void FindRootsInRange(const double * coefficient_block_ptr,
+                                 int degree,
+                                 int number_of_polynomials,
+                                 int first_index,
+                                 int end_index,
+                                 double * real_zero_block_ptr,
+                                 double * imaginary_zero_block_ptr,
+                                 PolynomialRootFinder::RootStatus_T * status_vector_ptr,
+                                 int * roots_found_vector_ptr);
+
+    static void FindLinearRoots(const double * coefficient_block_ptr,
+                                int number_of_polynomials,
+                                int first_index,
+                                int end_index,
+                                double * real_zero_block_ptr,
+                                double * imaginary_zero_block_ptr,
+                                PolynomialRootFinder::RootStatus_T * status_vector_ptr,
+                                int * roots_found_vector_ptr);
+
+    static void FindQuadraticRoots(const double * coefficient_block_ptr,
+                                   int number_of_polynomials,
+                                   int first_index,
+                                   int end_index,
+                                   double * real_zero_block_ptr,
+                                   double * imaginary_zero_block_ptr,
+                                   PolynomialRootFinder::RootStatus_T * status_vector_ptr,
+                                   int * roots_found_vector_ptr);
+
+    //==================================================================
+    //  This class only has static methods.
+    //==================================================================
+
+    PolynomialBatchRootFinder();
+};
+
+#endif
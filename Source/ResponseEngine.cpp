@@ -0,0 +1,329 @@
+/*
+  ==============================================================================
+
+    ResponseEngine.cpp
+    Created: 18 Oct 2026 8:27:33pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ResponseEngine.h"
+
+//==============================================================================
+ResponseEngine::ResponseEngine (int numPoints) : numPoints (numPoints)
+{
+    omega.resize (numPoints);
+    zInvReal.resize (numPoints);
+    zInvImag.resize (numPoints);
+
+    numReal.resize (numPoints);
+    numImag.resize (numPoints);
+    numDelay.resize (numPoints);
+    denReal.resize (numPoints);
+    denImag.resize (numPoints);
+    denDelay.resize (numPoints);
+    derivReal.resize (numPoints);
+    derivImag.resize (numPoints);
+
+    auto emptyResult = std::make_shared<Result>();
+    emptyResult->response.resize (numPoints);
+    emptyResult->groupDelay.resize (numPoints);
+    result = emptyResult;
+
+    setLogGrid (false);
+}
+
+void ResponseEngine::setLogGrid (bool logPlotToSet, double logBaseToSet)
+{
+    // called by every view that shares the engine before it calculates
+    if (isCalculated && logPlotToSet == logPlot && logBaseToSet == logBase)
+        return;
+
+    isCalculated = false;
+    logPlot = logPlotToSet;
+    logBase = logBaseToSet;
+
+    // same grid as the plots have always used: k = 1 ... numPoints, ending at pi
+    for (int k = 1; k <= numPoints; ++k)
+    {
+        omega[k-1] = positionToOmega (k / static_cast<double> (numPoints), logPlot, logBase);
+        zInvReal[k-1] = cos (omega[k-1]);
+        zInvImag[k-1] = -sin (omega[k-1]);
+    }
+}
+
+void ResponseEngine::setRoots (const std::vector<std::complex<double>>& zerosToSet, const std::vector<std::complex<double>>& polesToSet)
+{
+    zeros = zerosToSet;
+    poles = polesToSet;
+}
+
+void ResponseEngine::calculate (const std::vector<double>& coefficients)
+{
+    if (isCalculated && coefficients == calculatedCoefficients)
+        return;
+
+    isCalculated = true;
+    calculatedCoefficients = coefficients;
+
+    // the roots follow from the coefficients, so they do not need to be part of the key
+    AnalysisCache::Key key ("response", coefficients, { static_cast<double> (numPoints), logPlot ? 1.0 : 0.0, logBase });
+    if (auto cachedResult = cache->get<Result> (key))
+    {
+        result = cachedResult;
+        return;
+    }
+    
+    int halfNumCoeffs = Global::numCoeffs * 0.5;
+
+    // B(z^-1) = b0 + b1 z^-1 + ... and A(z^-1) = 1 - a1 z^-1 - ... as polynomials in z^-1
+    std::vector<double> numeratorCoeffs (coefficients.begin(), coefficients.begin() + halfNumCoeffs);
+    std::vector<double> denominatorCoeffs (halfNumCoeffs);
+    denominatorCoeffs[0] = 1.0;
+    for (int k = 1; k < halfNumCoeffs; ++k)
+        denominatorCoeffs[k] = -coefficients[k + halfNumCoeffs];
+
+    Polynomial numerator (&numeratorCoeffs[0], halfNumCoeffs - 1);
+    Polynomial denominator (&denominatorCoeffs[0], halfNumCoeffs - 1);
+
+    evaluate (numerator, numReal, numImag, numDelay);
+    evaluate (denominator, denReal, denImag, denDelay);
+
+    double sumAbsNumerator = 0;
+    double sumAbsDenominator = 0;
+    for (int k = 0; k < halfNumCoeffs; ++k)
+    {
+        sumAbsNumerator += std::abs (coefficients[k]);
+        sumAbsDenominator += std::abs (denominatorCoeffs[k]);
+    }
+
+    // points where the expanded polynomials have lost too many digits are evaluated from the roots instead
+    ProductForm productForm = makeProductForm (coefficients, zeros, poles);
+    auto newResult = std::make_shared<Result>();
+    std::vector<std::complex<double>>& response = newResult->response;
+    std::vector<double>& groupDelay = newResult->groupDelay;
+    response.resize (numPoints);
+    groupDelay.resize (numPoints);
+    for (int n = 0; n < numPoints; ++n)
+    {
+        if (productForm.valid
+            && (isIllConditioned (sumAbsNumerator, std::hypot (numReal[n], numImag[n]))
+                || isIllConditioned (sumAbsDenominator, std::hypot (denReal[n], denImag[n]))))
+        {
+            response[n] = evaluateProductForm (productForm, omega[n], groupDelay[n]);
+            ++newResult->numProductFormPoints;
+            continue;
+        }
+        response[n] = std::complex<double> (numReal[n], numImag[n]) / std::complex<double> (denReal[n], denImag[n]);
+        groupDelay[n] = numDelay[n] - denDelay[n];
+    }
+    
+    result = newResult;
+    cache->put<Result> (key, result, sizeof (Result) + AnalysisCache::getVectorBytes (response) + AnalysisCache::getVectorBytes (groupDelay));
+}
+
+ResponseEngine::ProductForm ResponseEngine::makeProductForm (const std::vector<double>& coefficients,
+                                                             const std::vector<std::complex<double>>& zeros,
+                                                             const std::vector<std::complex<double>>& poles)
+{
+    ProductForm productForm;
+    int halfNumCoeffs = Global::numCoeffs * 0.5;
+
+    // B(z^-1) = z^-lastB (b_firstB z^(lastB - firstB) + ... + b_lastB), so it has lastB - firstB zeros and gain b_firstB
+    int firstB = -1;
+    int lastB = -1;
+    for (int k = 0; k < halfNumCoeffs; ++k)
+    {
+        if (coefficients[k] == 0)
+            continue;
+        if (firstB == -1)
+            firstB = k;
+        lastB = k;
+    }
+
+    // A(z^-1) = z^-lastA (z^lastA - a1 z^(lastA - 1) - ... - a_lastA), so it has lastA poles
+    int lastA = 0;
+    for (int k = 1; k < halfNumCoeffs; ++k)
+        if (coefficients[k + halfNumCoeffs] != 0)
+            lastA = k;
+
+    if (firstB == -1 || static_cast<int> (zeros.size()) != lastB - firstB || static_cast<int> (poles.size()) != lastA)
+        return productForm;
+
+    productForm.valid = true;
+    productForm.logGain = log (std::abs (coefficients[firstB]));
+    productForm.gainPhase = coefficients[firstB] < 0 ? double_Pi : 0.0;
+    productForm.delay = lastB - lastA;
+    productForm.zeros = zeros;
+    productForm.poles = poles;
+    
+    // the same polynomials in z as the pole-zero plot solves
+    std::vector<double> numeratorCoeffs (lastB - firstB + 1);
+    for (int k = firstB; k <= lastB; ++k)
+        numeratorCoeffs[lastB - k] = coefficients[k];
+    std::vector<double> denominatorCoeffs (lastA + 1);
+    denominatorCoeffs[lastA] = 1.0;
+    for (int k = 1; k <= lastA; ++k)
+        denominatorCoeffs[lastA - k] = -coefficients[k + halfNumCoeffs];
+    
+    polishRoots (Polynomial (&numeratorCoeffs[0], lastB - firstB), productForm.zeros);
+    polishRoots (Polynomial (&denominatorCoeffs[0], lastA), productForm.poles);
+    return productForm;
+}
+
+void ResponseEngine::polishRoots (const Polynomial& polynomial, std::vector<std::complex<double>>& roots)
+{
+    // The root finder is only accurate to single precision, and clustered roots are its worst case. The product
+    // form is only as good as its roots, so they are refined in double precision first. Plain Newton steps from
+    // two roots of a cluster tend to run into the same root, so all roots are refined together with the
+    // Aberth-Ehrlich iteration, which pushes every root away from the others.
+    int numRoots = static_cast<int> (roots.size());
+    std::vector<std::complex<double>> refined (roots);
+    
+    for (int iteration = 0; iteration < Global::rootPolishIterations; ++iteration)
+    {
+        double largestStep = 0;
+        for (int i = 0; i < numRoots; ++i)
+        {
+            double valueReal, valueImag, derivReal, derivImag;
+            polynomial.EvaluateComplex (refined[i].real(), refined[i].imag(), valueReal, valueImag, derivReal, derivImag);
+            std::complex<double> value (valueReal, valueImag);
+            std::complex<double> derivative (derivReal, derivImag);
+            if (std::abs (value) == 0 || std::abs (derivative) == 0)
+                continue;
+            
+            std::complex<double> newtonStep = value / derivative;
+            std::complex<double> repulsion (0.0, 0.0);
+            for (int j = 0; j < numRoots; ++j)
+                if (j != i)
+                    repulsion += 1.0 / (refined[i] - refined[j]);
+            
+            std::complex<double> step = newtonStep / (1.0 - newtonStep * repulsion);
+            if (!std::isfinite (step.real()) || !std::isfinite (step.imag()))
+                continue;
+            
+            refined[i] -= step;
+            largestStep = std::max (std::abs (step), largestStep);
+        }
+        
+        if (largestStep < 1e-15)
+            break;
+    }
+    
+    // keep the refined roots only if they fit the polynomial better
+    double residual = 0;
+    double refinedResidual = 0;
+    for (int i = 0; i < numRoots; ++i)
+    {
+        double valueReal, valueImag;
+        polynomial.EvaluateComplex (roots[i].real(), roots[i].imag(), valueReal, valueImag);
+        residual += std::hypot (valueReal, valueImag);
+        polynomial.EvaluateComplex (refined[i].real(), refined[i].imag(), valueReal, valueImag);
+        refinedResidual += std::hypot (valueReal, valueImag);
+    }
+    if (refinedResidual <= residual)
+        roots = refined;
+}
+
+std::complex<double> ResponseEngine::evaluateProductForm (const ProductForm& productForm, double omega, double& groupDelay)
+{
+    // every factor e^jw - r adds log |e^jw - r| to the log magnitude, its angle to the phase
+    // and -Re{e^jw / (e^jw - r)} to the group delay (with the opposite signs for poles)
+    std::complex<double> z = std::polar (1.0, omega);
+    double logMagnitude = productForm.logGain;
+    double phase = productForm.gainPhase - productForm.delay * omega;
+    groupDelay = productForm.delay;
+
+    for (auto& zero : productForm.zeros)
+    {
+        std::complex<double> distance = z - zero;
+        logMagnitude += log (std::abs (distance));
+        phase += std::arg (distance);
+        groupDelay -= (z / distance).real();
+    }
+    for (auto& pole : productForm.poles)
+    {
+        std::complex<double> distance = z - pole;
+        logMagnitude -= log (std::abs (distance));
+        phase -= std::arg (distance);
+        groupDelay += (z / distance).real();
+    }
+
+    return std::polar (exp (logMagnitude), phase);
+}
+
+double ResponseEngine::positionToOmega (double position, bool logPlot, double logBase)
+{
+    if (logPlot)
+        return double_Pi * ((pow (logBase, position) - 1.0) / (logBase - 1.0));
+    return double_Pi * position;
+}
+
+double ResponseEngine::omegaToPosition (double omega, bool logPlot, double logBase)
+{
+    if (logPlot)
+        return log (omega / double_Pi * (logBase - 1.0) + 1.0) / log (logBase);
+    return omega / double_Pi;
+}
+
+void ResponseEngine::unwrapPhase (const std::vector<std::complex<double>>& response, std::vector<double>& phase, bool unwrap)
+{
+    phase.resize (response.size());
+    
+    double offset = 0;
+    double previous = std::numeric_limits<double>::quiet_NaN();
+    for (int n = 0; n < response.size(); ++n)
+    {
+        if (std::norm (response[n]) < 1e-30)
+        {
+            phase[n] = std::numeric_limits<double>::quiet_NaN();
+            continue;
+        }
+        
+        double wrapped = std::atan2 (response[n].imag(), response[n].real());
+        if (unwrap && !std::isnan (previous))
+            offset -= 2.0 * double_Pi * std::round ((wrapped + offset - previous) / (2.0 * double_Pi));
+        
+        phase[n] = wrapped + offset;
+        previous = phase[n];
+    }
+}
+
+void ResponseEngine::evaluate (const Polynomial& polynomial, std::vector<double>& real, std::vector<double>& imag, std::vector<double>& delay)
+{
+    horner (polynomial, real, imag);
+    horner (polynomial.Derivative(), derivReal, derivImag);
+
+    // With x = e^-jw, the phase of P(x) changes with d/dw (arg P) = -Re{x P'(x) / P(x)}, so the group delay
+    // -d/dw (arg P) is Re{x P'(x) / P(x)} = Re{x P'(x) conj (P(x))} / |P(x)|^2. No differencing of the phase needed.
+    for (int n = 0; n < numPoints; ++n)
+    {
+        double xDerivReal = zInvReal[n] * derivReal[n] - zInvImag[n] * derivImag[n];
+        double xDerivImag = zInvReal[n] * derivImag[n] + zInvImag[n] * derivReal[n];
+        delay[n] = (xDerivReal * real[n] + xDerivImag * imag[n]) / (real[n] * real[n] + imag[n] * imag[n]);
+    }
+}
+
+void ResponseEngine::horner (const Polynomial& polynomial, std::vector<double>& real, std::vector<double>& imag)
+{
+    // the loop over the grid is the inner loop so it has no dependencies and can be vectorised
+    int degree = polynomial.Degree();
+    for (int n = 0; n < numPoints; ++n)
+    {
+        real[n] = polynomial[degree];
+        imag[n] = 0.0;
+    }
+
+    for (int i = degree - 1; i >= 0; --i)
+    {
+        double coefficient = polynomial[i];
+        for (int n = 0; n < numPoints; ++n)
+        {
+            double temp = real[n] * zInvReal[n] - imag[n] * zInvImag[n] + coefficient;
+            imag[n] = real[n] * zInvImag[n] + imag[n] * zInvReal[n];
+            real[n] = temp;
+        }
+    }
+}
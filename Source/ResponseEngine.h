@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    ResponseEngine.h
+    Created: 18 Oct 2026 8:27:33pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include "Polynomial.h"
+#include "AnalysisCache.h"
+#include <complex>
+
+//==============================================================================
+/*
+    Evaluates the frequency response H(e^jw) and the group delay of the filter
+    on a grid of frequencies between 0 and pi (linearly or logarithmically spaced).
+    Both are calculated in one pass over the grid. The phase response and the
+    group delay share one engine (through a SharedResourcePointer), which only
+    evaluates again when the coefficients or the grid change, so with the same
+    grid the second view gets the result of the first. Results are also kept in
+    the shared analysis cache.
+*/
+class ResponseEngine
+{
+public:
+    ResponseEngine (int numPoints = Global::fftOrder);
+
+    void setLogGrid (bool logPlot, double logBase = 1000);
+    double getOmega (int idx) { return omega[idx]; };
+    int getNumPoints() { return numPoints; };
+
+    // the roots of the numerator and denominator in z (as found by the pole-zero plot)
+    void setRoots (const std::vector<std::complex<double>>& zerosToSet, const std::vector<std::complex<double>>& polesToSet);
+    
+    void calculate (const std::vector<double>& coefficients);
+
+    const std::vector<std::complex<double>>& getResponse() { return result->response; };
+    const std::vector<double>& getGroupDelay() { return result->groupDelay; }; // in samples
+    int getNumProductFormPoints() { return result->numProductFormPoints; };
+    
+    // map a position between 0 and 1 on the frequency axis of a plot to a frequency between 0 and pi, and back
+    static double positionToOmega (double position, bool logPlot, double logBase);
+    static double omegaToPosition (double omega, bool logPlot, double logBase);
+    
+    /*
+        H(e^jw) = g e^(-jw delay) prod (e^jw - z_i) / prod (e^jw - p_i)
+     
+        Evaluating the product of the root distances does not suffer from the cancellation that the expanded
+        polynomials have close to clustered roots. The product is accumulated as a sum of logarithms so it
+        cannot overflow or underflow.
+    */
+    struct ProductForm
+    {
+        bool valid = false;
+        double logGain = 0;
+        double gainPhase = 0; // 0 or pi
+        int delay = 0; // extra power of z^-1
+        std::vector<std::complex<double>> zeros;
+        std::vector<std::complex<double>> poles;
+    };
+    
+    // valid only if the number of roots matches the degrees of the polynomials of the coefficients
+    static ProductForm makeProductForm (const std::vector<double>& coefficients,
+                                        const std::vector<std::complex<double>>& zeros,
+                                        const std::vector<std::complex<double>>& poles);
+    static std::complex<double> evaluateProductForm (const ProductForm& productForm, double omega, double& groupDelay);
+    
+    // Horner's method loses about log10 (sum |c_k| / |P(x)|) digits, so above this the product form is used instead
+    static bool isIllConditioned (double sumAbsCoefficients, double absValue)
+    {
+        return absValue * Global::productFormCondition < sumAbsCoefficients;
+    };
+    
+    // Phase of a response in one pass. With unwrap, multiples of 2 pi are added so that neighbouring points never differ
+    // by more than pi. Points where the response is zero (zeros on the unit circle) have no phase and are set to NaN;
+    // unwrapping continues from the last point that had a phase.
+    static void unwrapPhase (const std::vector<std::complex<double>>& response, std::vector<double>& phase, bool unwrap = true);
+
+private:
+    struct Result
+    {
+        std::vector<std::complex<double>> response;
+        std::vector<double> groupDelay;
+        int numProductFormPoints = 0;
+    };
+    
+    // evaluates the polynomial in z^-1 on the whole grid, and Re{z^-1 P'(z^-1) / P(z^-1)}, which is its contribution to the group delay
+    void evaluate (const Polynomial& polynomial, std::vector<double>& real, std::vector<double>& imag, std::vector<double>& delay);
+    void horner (const Polynomial& polynomial, std::vector<double>& real, std::vector<double>& imag);
+    static void polishRoots (const Polynomial& polynomial, std::vector<std::complex<double>>& roots);
+
+    int numPoints;
+    bool logPlot = false;
+    double logBase = 1000;
+
+    // the grid and z^-1 = e^-jw on the grid, only recalculated when the grid changes
+    std::vector<double> omega;
+    std::vector<double> zInvReal;
+    std::vector<double> zInvImag;
+
+    std::vector<double> numReal, numImag, numDelay;
+    std::vector<double> denReal, denImag, denDelay;
+    std::vector<double> derivReal, derivImag;
+
+    std::vector<std::complex<double>> zeros;
+    std::vector<std::complex<double>> poles;
+    
+    // the coefficients and grid of result
+    bool isCalculated = false;
+    std::vector<double> calculatedCoefficients;
+
+    std::shared_ptr<const Result> result;
+    SharedResourcePointer<AnalysisCache> cache;
+};
@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    SignalGenerator.cpp
+    Created: 18 Oct 2026 8:49:50pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "SignalGenerator.h"
+
+//==============================================================================
+std::unique_ptr<SignalGenerator> SignalGenerator::create (Type type)
+{
+    switch (type)
+    {
+        case whiteNoise:
+            return std::make_unique<WhiteNoiseGenerator>();
+        case pinkNoise:
+            return std::make_unique<PinkNoiseGenerator>();
+        case logSweep:
+            return std::make_unique<LogSweepGenerator>();
+        case impulseTrain:
+            return std::make_unique<ImpulseTrainGenerator>();
+        case mls:
+            return std::make_unique<MLSGenerator>();
+        case square:
+            return std::make_unique<PolyBLEPGenerator> (true);
+        case saw:
+            return std::make_unique<PolyBLEPGenerator> (false);
+        default:
+            return nullptr;
+    }
+}
+
+String SignalGenerator::getName (Type type)
+{
+    switch (type)
+    {
+        case whiteNoise:
+            return "White noise";
+        case pinkNoise:
+            return "Pink noise";
+        case logSweep:
+            return "Log. sweep";
+        case impulseTrain:
+            return "Impulses";
+        case mls:
+            return "MLS";
+        case square:
+            return "Square";
+        case saw:
+            return "Sawtooth";
+        default:
+            return "";
+    }
+}
+
+//==============================================================================
+void PinkNoiseGenerator::reset()
+{
+    noise.fillUniform (rows, numRows, -0.5, 0.5);
+    rowSum = 0;
+    for (int k = 0; k < numRows; ++k)
+        rowSum += rows[k];
+    counter = 0;
+}
+
+void PinkNoiseGenerator::process (double* output, int numSamples)
+{
+    // scaled so that the standard deviation is the same as that of the white noise
+    const double scaling = 1.0 / sqrt (numRows + 1.0);
+
+    int n = 0;
+    while (n < numSamples)
+    {
+        int numToProcess = jmin (Global::audioBlockSize, numSamples - n);
+        noise.fillUniform (random, 2 * numToProcess, -0.5, 0.5);
+
+        for (int i = 0; i < numToProcess; ++i)
+        {
+            // the row to update is the number of trailing zeros of the counter, so row k changes every 2^(k+1) samples
+            ++counter;
+            int row = 0;
+            uint32 bits = counter;
+            while ((bits & 1) == 0 && row < numRows - 1)
+            {
+                bits >>= 1;
+                ++row;
+            }
+            rowSum += random[2 * i] - rows[row];
+            rows[row] = random[2 * i];
+
+            output[n + i] = (rowSum + random[2 * i + 1]) * scaling;
+        }
+        n += numToProcess;
+    }
+}
+
+//==============================================================================
+void LogSweepGenerator::reset()
+{
+    startFrequency = Global::sweepStartFrequency;
+    double endFrequency = jmin (Global::sweepEndFrequency, 0.45 * fs);
+    length = std::max (1, static_cast<int> (Global::sweepLength * fs));
+
+    // f[n] = f1 (f2 / f1)^(n / length)
+    frequencyFactor = pow (endFrequency / startFrequency, 1.0 / length);
+
+    // The sweep goes through sum f[n] / fs = f1 (k^length - 1) / ((k - 1) fs) cycles. All frequencies are scaled
+    // a little so that this is a whole number, and the phase is back at 0 when the sweep starts again.
+    double numCycles = frequencyFactor == 1.0 ? length * startFrequency / fs
+                                              : startFrequency * (pow (frequencyFactor, length) - 1.0) / ((frequencyFactor - 1.0) * fs);
+    startFrequency *= jmax (1.0, std::round (numCycles)) / numCycles;
+
+    phase = 0;
+    frequency = startFrequency;
+    n = 0;
+}
+
+void LogSweepGenerator::process (double* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        output[i] = 0.5 * sin (phase);
+
+        phase += 2.0 * double_Pi * frequency / fs;
+        if (phase >= 2.0 * double_Pi)
+            phase -= 2.0 * double_Pi;
+        frequency *= frequencyFactor;
+
+        // start again at the start frequency, at a zero crossing
+        if (++n >= length)
+        {
+            n = 0;
+            phase = 0;
+            frequency = startFrequency;
+        }
+    }
+}
+
+//==============================================================================
+void ImpulseTrainGenerator::reset()
+{
+    period = std::max (1, static_cast<int> (Global::impulsePeriod * fs));
+    n = 0;
+}
+
+void ImpulseTrainGenerator::process (double* output, int numSamples)
+{
+    std::fill (output, output + numSamples, 0.0);
+
+    // jump from impulse to impulse instead of looking at every sample
+    int i = n == 0 ? 0 : period - n;
+    for (; i < numSamples; i += period)
+        output[i] = 1.0;
+    n = (n + numSamples) % period;
+}
+
+//==============================================================================
+void MLSGenerator::process (double* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // x^16 + x^14 + x^13 + x^11 + 1
+        uint32 bit = state & 1;
+        state >>= 1;
+        if (bit)
+            state ^= 0xB400u;
+        output[i] = bit ? 0.5 : -0.5;
+    }
+}
+
+//==============================================================================
+double PolyBLEPGenerator::polyBLEP (double t, double dt)
+{
+    // just after the jump
+    if (t < dt)
+    {
+        t /= dt;
+        return t + t - t * t - 1.0;
+    }
+
+    // just before the jump
+    if (t > 1.0 - dt)
+    {
+        t = (t - 1.0) / dt;
+        return t * t + t + t + 1.0;
+    }
+    return 0.0;
+}
+
+void PolyBLEPGenerator::process (double* output, int numSamples)
+{
+    const double dt = Global::oscillatorFrequency / fs;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        double value;
+        if (isSquare)
+        {
+            // a jump up at phase 0 and down at phase 0.5
+            value = phase < 0.5 ? 1.0 : -1.0;
+            value += polyBLEP (phase, dt);
+            value -= polyBLEP (fmod (phase + 0.5, 1.0), dt);
+        }
+        else
+        {
+            // a jump down at phase 0
+            value = 2.0 * phase - 1.0;
+            value -= polyBLEP (phase, dt);
+        }
+        output[i] = 0.5 * value;
+
+        phase += dt;
+        if (phase >= 1.0)
+            phase -= 1.0;
+    }
+}
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    SignalGenerator.h
+    Created: 18 Oct 2026 8:49:50pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include "NoiseGenerator.h"
+
+using namespace juce;
+//==============================================================================
+/*
+    Test signals that can be used as the input of the filter. Generators render
+    blocks of samples and do not allocate after construction, so they can run
+    on the audio thread. The periodic signals stay within +/- 0.5 (impulses
+    are 1), the noise has about the RMS level of uniform noise in +/- 0.5.
+*/
+class SignalGenerator
+{
+public:
+    enum Type
+    {
+        whiteNoise = 0,
+        pinkNoise,
+        logSweep,
+        impulseTrain,
+        mls,
+        square,
+        saw,
+        numTypes
+    };
+
+    virtual ~SignalGenerator() = default;
+
+    static std::unique_ptr<SignalGenerator> create (Type type);
+    static String getName (Type type);
+
+    virtual void prepare (double sampleRate) { fs = sampleRate; reset(); };
+
+    // start the signal from the beginning
+    virtual void reset() {};
+
+    virtual void process (double* output, int numSamples) = 0;
+
+protected:
+    double fs = 44100.0;
+};
+
+//==============================================================================
+class WhiteNoiseGenerator : public SignalGenerator
+{
+public:
+    void process (double* output, int numSamples) override { noise.fillUniform (output, numSamples, -0.5, 0.5); };
+
+private:
+    NoiseGenerator noise;
+};
+
+//==============================================================================
+/*
+    Voss-McCartney: numRows white noise values that are updated at halving rates
+    (row k every 2^(k+1) samples) plus a white one, summed.
+*/
+class PinkNoiseGenerator : public SignalGenerator
+{
+public:
+    void reset() override;
+    void process (double* output, int numSamples) override;
+
+    static const int numRows = 16;
+
+private:
+    NoiseGenerator noise;
+    double rows[numRows];
+    double rowSum = 0;
+    uint32 counter = 0;
+    double random[2 * Global::audioBlockSize];
+};
+
+//==============================================================================
+// Exponential sine sweep from Global::sweepStartFrequency up to Global::sweepEndFrequency (or close to fs / 2), repeated.
+// Every sweep is a whole number of cycles, so it starts again without a click.
+class LogSweepGenerator : public SignalGenerator
+{
+public:
+    void reset() override;
+    void process (double* output, int numSamples) override;
+
+private:
+    double frequencyFactor = 1.0; // the instantaneous frequency is multiplied by this every sample
+    double startFrequency = 20.0;
+    int length = 1;
+
+    double phase = 0;
+    double frequency = 0;
+    int n = 0;
+};
+
+//==============================================================================
+class ImpulseTrainGenerator : public SignalGenerator
+{
+public:
+    void reset() override;
+    void process (double* output, int numSamples) override;
+
+private:
+    int period = 1;
+    int n = 0;
+};
+
+//==============================================================================
+// Maximum length sequence from a 16 bit Galois LFSR, so it repeats every 65535 samples.
+class MLSGenerator : public SignalGenerator
+{
+public:
+    void reset() override { state = 1; };
+    void process (double* output, int numSamples) override;
+
+private:
+    uint32 state = 1;
+};
+
+//==============================================================================
+// Band-limited square or sawtooth wave at Global::oscillatorFrequency, with PolyBLEP corrections at the jumps.
+class PolyBLEPGenerator : public SignalGenerator
+{
+public:
+    PolyBLEPGenerator (bool isSquare) : isSquare (isSquare) {};
+
+    void reset() override { phase = 0; };
+    void process (double* output, int numSamples) override;
+
+private:
+    // correction of a unit jump at phase 0 for a phase increment of dt
+    static double polyBLEP (double t, double dt);
+
+    bool isSquare;
+    double phase = 0;
+};
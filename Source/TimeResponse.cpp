@@ -0,0 +1,270 @@
+/*
+  ==============================================================================
+
+    TimeResponse.cpp
+    Created: 18 Oct 2026 8:29:02pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "TimeResponse.h"
+
+//==============================================================================
+TimeResponse::TimeResponse (double fs) : AppComponent ("Time Response", false), fs (fs)
+{
+    block.resize (Global::timeResponseBlockSize);
+
+    stepButton = std::make_unique<TextButton> ();
+    stepButton->setButtonText (showStep ? "Impulse" : "Step");
+    stepButton->addListener (this);
+    addAndMakeVisible (stepButton.get());
+
+    lengthBox = std::make_unique<ComboBox> ();
+    int id = 1;
+    for (int numSamples = 1024; numSamples <= Global::maxTimeResponseLength; numSamples *= 4)
+    {
+        lengthBox->addItem (numSamples >= 1048576 ? String (numSamples / 1048576) + "M" : String (numSamples), id);
+        if (numSamples == length)
+            lengthBox->setSelectedId (id, dontSendNotification);
+        ++id;
+    }
+    lengthBox->addListener (this);
+    addAndMakeVisible (lengthBox.get());
+}
+
+TimeResponse::~TimeResponse()
+{
+}
+
+void TimeResponse::paint (juce::Graphics& g)
+{
+    drawAppComp (g);
+
+    if (current == nullptr)
+        return;
+
+    double visualScaling = plotHeight / (highestValue - lowestValue);
+
+    //// Draw zero line ////
+    if (lowestValue < 0 && highestValue > 0)
+    {
+        g.setColour (Colours::lightgrey);
+        double zeroHeight = plotYStart + highestValue * visualScaling;
+        g.drawLine (Global::axisMargin + Global::margin, zeroHeight, getWidth(), zeroHeight, 1.0);
+    }
+
+    //// Plot ////
+    g.setColour (current->unstable ? Colours::red : Colours::black);
+    g.strokePath (generateResponsePath(), PathStrokeType(1.0f));
+
+    //// Draw axes ////
+    g.setColour (Colours::black);
+    g.drawLine (Global::margin + Global::axisMargin,
+                plotYStart,
+                Global::margin + Global::axisMargin,
+                getHeight() - Global::axisMargin - Global::margin);
+
+    g.drawLine (Global::margin + Global::axisMargin,
+                getHeight() - Global::axisMargin - Global::margin,
+                getWidth(),
+                getHeight() - Global::axisMargin - Global::margin);
+
+    //// Draw labels ////
+    g.setFont (equationFont.withHeight (14.0f));
+    g.drawText (String (highestValue, 2),
+                0.0f,
+                plotYStart - equationFont.getHeight() * 0.5,
+                Global::axisMargin + Global::margin * 0.5,
+                equationFont.getHeight(), Justification::centredRight, false);
+
+    g.drawText (String (lowestValue, 2),
+                0.0f,
+                plotYStart + plotHeight - equationFont.getHeight() * 0.5,
+                Global::axisMargin + Global::margin * 0.5,
+                equationFont.getHeight(), Justification::centredRight, false);
+
+    g.drawText ("0", Global::axisMargin, getHeight() - Global::axisMargin - Global::margin, 20, 20, Justification::centred);
+    g.drawText (String (1000.0 * current->length / fs, 1) + " ms",
+                getWidth() - 100 - Global::margin, getHeight() - Global::axisMargin - Global::margin,
+                100, 20, Justification::centredRight);
+
+    String decayText;
+    if (current->unstable)
+        decayText = "Unstable";
+    else if (current->decaySample == -1)
+        decayText = "No decay";
+    else if (current->samplesRun < current->length)
+        decayText = String (Global::timeResponseDecayDB) + " dB after " + String (1000.0 * (current->decaySample + 1) / fs, 2) + " ms";
+    else
+        decayText = "Still above " + String (Global::timeResponseDecayDB) + " dB";
+
+    g.drawText (decayText, Global::axisMargin + Global::margin, getHeight() - Global::margin - 20,
+                getWidth() - Global::axisMargin - 2.0 * Global::margin, 20, Justification::centred);
+}
+
+void TimeResponse::resized()
+{
+    stepButton->setBounds (getWidth() - 100 - Global::margin, Global::margin, 100, 25);
+    lengthBox->setBounds (getWidth() - 190 - Global::margin, Global::margin, 80, 25);
+    plotHeight = (getHeight() - Global::axisMargin - Global::margin - plotYStart);
+}
+
+Path TimeResponse::generateResponsePath()
+{
+    // every bin is drawn as a vertical line from its minimum to its maximum
+    Path response;
+    double visualScaling = plotHeight / (highestValue - lowestValue);
+    double spacing = (getWidth() - Global::margin - Global::axisMargin) / static_cast<double> (current->minData.size());
+    double x = Global::margin + Global::axisMargin;
+    bool startNewSubPath = true;
+    for (int i = 0; i < current->minData.size(); ++i)
+    {
+        if (std::isfinite (current->minData[i]) && std::isfinite (current->maxData[i]))
+        {
+            float yMax = plotYStart + (highestValue - current->maxData[i]) * visualScaling;
+            float yMin = plotYStart + (highestValue - current->minData[i]) * visualScaling;
+            if (startNewSubPath)
+                response.startNewSubPath (x, yMax);
+            else
+                response.lineTo (x, yMax);
+            response.lineTo (x, yMin);
+            startNewSubPath = false;
+        }
+        else
+        {
+            startNewSubPath = true;
+        }
+        x += spacing;
+    }
+    return response;
+}
+
+void TimeResponse::calculate()
+{
+    AnalysisCache::Key key (showStep ? "step response" : "impulse response", coefficients, { static_cast<double> (length) });
+    current = analysisCache->get<Result> (key);
+    if (current == nullptr)
+    {
+        current = run (showStep);
+        analysisCache->put<Result> (key, current, sizeof (Result) + AnalysisCache::getVectorBytes (current->minData)
+                                                  + AnalysisCache::getVectorBytes (current->maxData));
+    }
+    const Result& result = *current;
+
+    highestValue = 0;
+    lowestValue = 0;
+    for (int i = 0; i < result.minData.size(); ++i)
+    {
+        if (!std::isfinite (result.minData[i]) || !std::isfinite (result.maxData[i]))
+            continue;
+        highestValue = std::max (result.maxData[i], highestValue);
+        lowestValue = std::min (result.minData[i], lowestValue);
+    }
+    if (highestValue - lowestValue < 1e-9)
+        highestValue = lowestValue + 1.0;
+}
+
+std::shared_ptr<const TimeResponse::Result> TimeResponse::run (bool step)
+{
+    auto newResult = std::make_shared<Result>();
+    Result& result = *newResult;
+    result.length = length;
+    result.samplesPerBin = (length + Global::timeResponseBins - 1) / Global::timeResponseBins;
+
+    int numBins = (length + result.samplesPerBin - 1) / result.samplesPerBin;
+    result.minData.assign (numBins, std::numeric_limits<double>::max());
+    result.maxData.assign (numBins, std::numeric_limits<double>::lowest());
+
+    // the value the response settles to: 0 for the impulse response and the gain at DC for the step response
+    double finalValue = 0;
+    if (step)
+    {
+        double numerator = 0;
+        double denominator = 1.0;
+        for (int k = 0; k < Global::numCoeffs * 0.5; ++k)
+        {
+            numerator += coefficients[k];
+            if (k > 0)
+                denominator -= coefficients[k + Global::numCoeffs * 0.5];
+        }
+        finalValue = denominator != 0 ? numerator / denominator : 0;
+    }
+
+    double threshold = pow (10.0, Global::timeResponseDecayDB / 20.0);
+    double peakDeviation = 0;
+
+    // the engine is kept between calls, and a ramp from the previous coefficients would end up in the response
+    filterEngine.setCoefficients (coefficients, false);
+    filterEngine.reset();
+
+    result.unstable = false;
+    result.decaySample = -1;
+    int n = 0;
+    while (n < length)
+    {
+        int numSamples = jmin (Global::timeResponseBlockSize, length - n);
+        std::fill (block.begin(), block.begin() + numSamples, step ? 1.0 : 0.0);
+        if (n == 0 && !step)
+            block[0] = 1.0;
+
+        filterEngine.process (&block[0], &block[0], numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            int bin = (n + i) / result.samplesPerBin;
+            result.minData[bin] = std::min (block[i], result.minData[bin]);
+            result.maxData[bin] = std::max (block[i], result.maxData[bin]);
+
+            double deviation = std::abs (block[i] - finalValue);
+            peakDeviation = std::max (deviation, peakDeviation);
+            if (deviation > threshold * peakDeviation)
+                result.decaySample = n + i;
+        }
+        n += numSamples;
+
+        if (!std::isfinite (block[numSamples - 1]) || std::abs (block[numSamples - 1]) > Global::timeResponseBlowUp)
+        {
+            result.unstable = true;
+            break;
+        }
+
+        // stop as soon as a whole block has stayed within the threshold
+        if (n - 1 - result.decaySample >= Global::timeResponseBlockSize)
+            break;
+    }
+    result.samplesRun = n;
+
+    // what is left of the response stays at the final value
+    for (int bin = (n - 1) / result.samplesPerBin; bin < numBins; ++bin)
+    {
+        if (result.unstable)
+        {
+            if (bin * result.samplesPerBin >= n)
+                result.minData[bin] = result.maxData[bin] = std::numeric_limits<double>::quiet_NaN();
+            continue;
+        }
+        result.minData[bin] = std::min (finalValue, result.minData[bin]);
+        result.maxData[bin] = std::max (finalValue, result.maxData[bin]);
+    }
+    return newResult;
+}
+
+void TimeResponse::buttonClicked (Button* button)
+{
+    showStep = !showStep;
+    stepButton->setButtonText (showStep ? "Impulse" : "Step");
+    refresh();
+}
+
+void TimeResponse::comboBoxChanged (ComboBox* comboBox)
+{
+    setLength (1024 << (2 * (lengthBox->getSelectedId() - 1)));
+}
+
+void TimeResponse::setLength (int numSamples)
+{
+    length = Global::limit (numSamples, 1, Global::maxTimeResponseLength);
+    refresh();
+}
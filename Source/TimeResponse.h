@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    TimeResponse.h
+    Created: 18 Oct 2026 8:29:02pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include "AppComponent.h"
+#include "FilterEngine.h"
+
+//==============================================================================
+/*
+    Impulse or step response of the filter. The response is run through the
+    filter engine block by block and only kept as a min/max envelope per display
+    bin, so long lengths do not need to be stored.
+*/
+class TimeResponse  : public AppComponent, public Button::Listener, public ComboBox::Listener
+{
+public:
+    TimeResponse (double fs);
+    ~TimeResponse() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    void calculate() override;
+    Path generateResponsePath();
+
+    void buttonClicked (Button* button) override;
+    void comboBoxChanged (ComboBox* comboBox) override;
+
+    void setLength (int numSamples);
+
+    void setSampleRate (double sampleRate) override { fs = sampleRate; repaint(); };
+
+private:
+    struct Result
+    {
+        int length = 0;
+        int samplesPerBin = 1;
+
+        std::vector<double> minData;
+        std::vector<double> maxData;
+
+        int samplesRun = 0;
+        int decaySample = -1; // last sample that was further than the threshold from the final value
+        bool unstable = false;
+    };
+
+    std::shared_ptr<const Result> run (bool step);
+
+    bool showStep = false;
+    int length = Global::timeResponseLength;
+    double fs;
+
+    // the impulse and step responses are kept in the analysis cache, so switching between them is free
+    std::shared_ptr<const Result> current;
+    double highestValue = 1;
+    double lowestValue = -1;
+
+    FilterEngine filterEngine;
+    std::vector<double> block;
+
+    double plotYStart = 40 + Global::margin;
+    double plotHeight = 1;
+
+    std::unique_ptr<TextButton> stepButton;
+    std::unique_ptr<ComboBox> lengthBox;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimeResponse)
+};
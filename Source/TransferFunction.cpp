@@ -16,11 +16,15 @@ TransferFunction::TransferFunction() : AppComponent ("Transfer Function", true)
 {
     // In your constructor, you should add any child components, and
     // initialise any special settings that your component needs.
+    layout = std::make_shared<Layout>();
+}
+
+TransferFunction::Layout::Layout()
+{
     xPowers.resize (Global::numCoeffs * 0.5);
     yPowers.resize (Global::numCoeffs * 0.5);
     xPowerLocs.resize (Global::numCoeffs * 0.5);
     yPowerLocs.resize (Global::numCoeffs * 0.5);
-
 }
 
 TransferFunction::~TransferFunction()
@@ -38,24 +42,13 @@ void TransferFunction::paint (juce::Graphics& g)
     
     drawAppComp (g);
 
-    //reset all vectors
-    
-    xPowersAmount = 0;
-    yPowersAmount = 0;
-    
-    xPowers.resize (Global::numCoeffs * 0.5, 0);
-    yPowers.resize (Global::numCoeffs * 0.5, 0);
-    
-    xPowerLocs.resize (Global::numCoeffs * 0.5, 0);
-    yPowerLocs.resize (Global::numCoeffs * 0.5, 0);
-
     Font font = equationFont;
     String equation = "H(z) = ";
-    if (!hasYcomponent)
+    if (!layout->hasYcomponent)
     {
-        equation += xEquation;
+        equation += layout->xEquation;
     } else {
-        equation += (equationFont.getStringWidthFloat (xEquation) > equationFont.getStringWidthFloat (yEquation) ? xEquation : yEquation);
+        equation += (equationFont.getStringWidthFloat (layout->xEquation) > equationFont.getStringWidthFloat (layout->yEquation) ? layout->xEquation : layout->yEquation);
     }
     
     while (font.getStringWidthFloat (equation) > getWidth() - 2.0 * Global::margin)
@@ -67,66 +60,62 @@ void TransferFunction::paint (juce::Graphics& g)
 //    transform = transform.translated (Global::margin * (1.0 - scaling), (30 + Global::margin) * (1.0 - scaling));
     g.addTransform (transform);
     
-    if (!hasYcomponent)
+    if (!layout->hasYcomponent)
     {
         g.drawText ("H(z) = ", Global::margin, (getHeight() + Global::margin + 12.5) * 0.5 - 12.5, getWidth(), 25, Justification::centredLeft, false);
-        removePowers (xEquation, xEquationWithoutPowers, true);
         
         // Draw main equation (without powers)
         
-        g.drawText (xEquationWithoutPowers, Global::margin + 65, (getHeight() + Global::margin + 12.5) * 0.5 - 12.5, getWidth() * 1.0 / scaling,  25, Justification::centredLeft, false);
+        g.drawText (layout->xEquationWithoutPowers, Global::margin + 65, (getHeight() + Global::margin + 12.5) * 0.5 - 12.5, getWidth() * 1.0 / scaling,  25, Justification::centredLeft, false);
         
         // Draw powers
         g.setFont (equationFont.withHeight(16.0f));
-        for (int i = 0; i < xPowersAmount; ++i)
-            g.drawText("-" + String (xPowers[i]),
-                       Global::margin + 65 + xPowerLocs[i],
+        for (int i = 0; i < layout->xPowersAmount; ++i)
+            g.drawText("-" + String (layout->xPowers[i]),
+                       Global::margin + 65 + layout->xPowerLocs[i],
                        (getHeight() + Global::margin + 12.5) * 0.5 - 12.5,
-                       equationFont.getStringWidthFloat("-" + String (xPowers[i])),
+                       equationFont.getStringWidthFloat("-" + String (layout->xPowers[i])),
                        16,
                        Justification::centred);
         
     } else {
         
-        removePowers (xEquation, xEquationWithoutPowers, true);
-        removePowers (yEquation, yEquationWithoutPowers, false);
-        
-        float totStringWidth = std::max (equationFont.getStringWidthFloat (xEquationWithoutPowers), equationFont.getStringWidthFloat (yEquationWithoutPowers));
+        float totStringWidth = std::max (equationFont.getStringWidthFloat (layout->xEquationWithoutPowers), equationFont.getStringWidthFloat (layout->yEquationWithoutPowers));
 
         float xPowersOffset = 0;
         float yPowersOffset = 0;
 
         // Calculate offset for numerator or denominator if the other is bigger
-        if (equationFont.getStringWidthFloat (xEquation) > equationFont.getStringWidthFloat (yEquationWithoutPowers))
-            yPowersOffset = (equationFont.getStringWidthFloat (xEquationWithoutPowers) + equationFont.getStringWidthFloat (yEquationWithoutPowers)) * 0.5 - equationFont.getStringWidthFloat (yEquationWithoutPowers);
+        if (equationFont.getStringWidthFloat (layout->xEquation) > equationFont.getStringWidthFloat (layout->yEquationWithoutPowers))
+            yPowersOffset = (equationFont.getStringWidthFloat (layout->xEquationWithoutPowers) + equationFont.getStringWidthFloat (layout->yEquationWithoutPowers)) * 0.5 - equationFont.getStringWidthFloat (layout->yEquationWithoutPowers);
         else
-            xPowersOffset = (equationFont.getStringWidthFloat (xEquationWithoutPowers) + equationFont.getStringWidthFloat (yEquationWithoutPowers)) * 0.5 - equationFont.getStringWidthFloat (xEquationWithoutPowers);
+            xPowersOffset = (equationFont.getStringWidthFloat (layout->xEquationWithoutPowers) + equationFont.getStringWidthFloat (layout->yEquationWithoutPowers)) * 0.5 - equationFont.getStringWidthFloat (layout->xEquationWithoutPowers);
         
         // Draw main equation (without powers)
         g.drawText ("H(z) = ", Global::margin, (getHeight() + Global::margin + 12.5) * 0.5 - 12.5, getWidth(), 25, Justification::centredLeft, false);
-        g.drawText(xEquationWithoutPowers, 65 + Global::margin, (getHeight() + Global::margin + 12.5) * 0.5 - 12.5 - 15, totStringWidth, 25, Justification::centred, false);
+        g.drawText(layout->xEquationWithoutPowers, 65 + Global::margin, (getHeight() + Global::margin + 12.5) * 0.5 - 12.5 - 15, totStringWidth, 25, Justification::centred, false);
         g.setColour (Colours::black);
         g.drawLine (Global::margin + 65,
                     (getHeight() + Global::margin + 12.5) * 0.5,
                     80 + totStringWidth + Global::margin,
                     (getHeight() + Global::margin + 12.5) * 0.5);
         
-        g.drawText(yEquationWithoutPowers, Global::margin + 65, (getHeight() + Global::margin + 12.5) * 0.5 - 12.5 + 15, totStringWidth, 25, Justification::centred, false);
+        g.drawText(layout->yEquationWithoutPowers, Global::margin + 65, (getHeight() + Global::margin + 12.5) * 0.5 - 12.5 + 15, totStringWidth, 25, Justification::centred, false);
         
         // Draw powers
         g.setFont (equationFont.withHeight(16.0f));
-        for (int i = 0; i < xPowersAmount; ++i)
-            g.drawText("-" + String (xPowers[i]),
-                       Global::margin + 70 + xPowerLocs[i] + xPowersOffset,
+        for (int i = 0; i < layout->xPowersAmount; ++i)
+            g.drawText("-" + String (layout->xPowers[i]),
+                       Global::margin + 70 + layout->xPowerLocs[i] + xPowersOffset,
                        (getHeight() + Global::margin + 12.5) * 0.5 - 12.5 - 15,
-                       equationFont.getStringWidthFloat("-" + String (xPowers[i])),
+                       equationFont.getStringWidthFloat("-" + String (layout->xPowers[i])),
                        16, Justification::centredRight);
         
-        for (int i = 0; i < yPowersAmount; ++i)
-            g.drawText("-" + String (yPowers[i]),
-                       Global::margin + 70 + yPowerLocs[i] + yPowersOffset,
+        for (int i = 0; i < layout->yPowersAmount; ++i)
+            g.drawText("-" + String (layout->yPowers[i]),
+                       Global::margin + 70 + layout->yPowerLocs[i] + yPowersOffset,
                        (getHeight() + Global::margin + 12.5) * 0.5 - 12.5 + 15,
-                       equationFont.getStringWidthFloat("-" + String (yPowers[i])),
+                       equationFont.getStringWidthFloat("-" + String (layout->yPowers[i])),
                        16, Justification::centredRight);
     }
 
@@ -141,6 +130,18 @@ void TransferFunction::resized()
 
 void TransferFunction::calculate()
 {
+    AnalysisCache::Key key ("transfer function", coefficients);
+    if (auto cachedLayout = analysisCache->get<Layout> (key))
+    {
+        layout = cachedLayout;
+        return;
+    }
+    
+    auto newLayout = std::make_shared<Layout>();
+    String& xEquation = newLayout->xEquation;
+    String& yEquation = newLayout->yEquation;
+    bool& hasYcomponent = newLayout->hasYcomponent;
+    
     xEquation = "";
     
     // x-component
@@ -203,11 +204,21 @@ void TransferFunction::calculate()
     
     if (yEquation == "1")
         hasYcomponent = false;
+    
+    // the layout of the powers only depends on the equations, so it is worked out here instead of on every paint
+    removePowers (xEquation, newLayout->xEquationWithoutPowers, newLayout->xPowers, newLayout->xPowerLocs, newLayout->xPowersAmount);
+    removePowers (yEquation, newLayout->yEquationWithoutPowers, newLayout->yPowers, newLayout->yPowerLocs, newLayout->yPowersAmount);
+    
+    layout = newLayout;
+    analysisCache->put<Layout> (key, layout, sizeof (Layout) + xEquation.getNumBytesAsUTF8() + yEquation.getNumBytesAsUTF8()
+                                             + newLayout->xEquationWithoutPowers.getNumBytesAsUTF8() + newLayout->yEquationWithoutPowers.getNumBytesAsUTF8()
+                                             + 2 * AnalysisCache::getVectorBytes (newLayout->xPowers) + 2 * AnalysisCache::getVectorBytes (newLayout->xPowerLocs));
 }
 
-void TransferFunction::removePowers (String equation, String& equationWithoutPowers, bool isX)
+void TransferFunction::removePowers (String equation, String& equationWithoutPowers, std::vector<int>& powers, std::vector<float>& powerLocs, int& powersAmount)
 {
     equationWithoutPowers = "";
+    powersAmount = 0;
     
     if (!equation.contains("z"))
     {
@@ -230,23 +241,13 @@ void TransferFunction::removePowers (String equation, String& equationWithoutPow
         }
         equation = equation.fromFirstOccurrenceOf ("^-", false, false);
         
-        if (isX)
-        {
-            xPowers[idx] = equation.substring(0, 1).getIntValue();
-            xPowerLocs[idx] = equationFont.getStringWidthFloat (equationWithoutPowers);
-        } else {
-            yPowers[idx] = equation.substring(0, 1).getIntValue();
-            yPowerLocs[idx] = equationFont.getStringWidthFloat (equationWithoutPowers);
-
-        }
+        powers[idx] = equation.substring(0, 1).getIntValue();
+        powerLocs[idx] = equationFont.getStringWidthFloat (equationWithoutPowers);
         
         ++idx;
         equation = equation.substring (2, equation.length());
         equationWithoutPowers += "   ";
 
     }
-    if (isX)
-        xPowersAmount = idx;
-    else
-        yPowersAmount = idx;
+    powersAmount = idx;
 }
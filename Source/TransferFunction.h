@@ -28,22 +28,30 @@ public:
     
     void calculate() override;
 
-    void removePowers (String equation, String& equationWithoutPowers, bool isX);
+    void removePowers (String equation, String& equationWithoutPowers, std::vector<int>& powers, std::vector<float>& powerLocs, int& powersAmount);
 private:
-    String xEquation;
-    String yEquation;
-    String xEquationWithoutPowers;
-    String yEquationWithoutPowers;
-
-    std::vector<int> xPowers;
-    std::vector<int> yPowers;
-    std::vector<float> xPowerLocs;
-    std::vector<float> yPowerLocs;
+    // the equations and where their powers go, kept in the analysis cache
+    struct Layout
+    {
+        Layout();
+        
+        String xEquation;
+        String yEquation;
+        String xEquationWithoutPowers;
+        String yEquationWithoutPowers;
+
+        std::vector<int> xPowers;
+        std::vector<int> yPowers;
+        std::vector<float> xPowerLocs;
+        std::vector<float> yPowerLocs;
+        
+        int xPowersAmount = 0;
+        int yPowersAmount = 0;
+
+        bool hasYcomponent = false;
+    };
     
-    int xPowersAmount = 0;
-    int yPowersAmount = 0;
-
-    bool hasYcomponent = false;
+    std::shared_ptr<const Layout> layout;
     
     float scaling = 1.0f;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TransferFunction)
@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+    ZPlaneHeatmap.cpp
+    Created: 18 Oct 2026 8:25:36pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ZPlaneHeatmap.h"
+
+//==============================================================================
+// One set of coefficients and one view. The tiles only write to their own part of the buffers
+// and then set their bit in tileState, so the message thread can read finished tiles while others are running.
+struct ZPlaneHeatmap::Frame
+{
+    uint32 generation;
+
+    double b[Global::numCoeffs / 2];
+    double a[Global::numCoeffs / 2];
+
+    double realMin, realStep;
+    double imagMax, imagStep;
+    int width, height;
+    int numTilesX, numTilesY;
+
+    std::vector<float> coarseDB;
+    std::vector<float> fineDB;
+    std::unique_ptr<std::atomic<int>[]> tileState; // bit 0 : coarse done, bit 1 : full resolution done
+};
+
+//==============================================================================
+class ZPlaneHeatmap::TileJob : public ThreadPoolJob
+{
+public:
+    TileJob (ZPlaneHeatmap& owner, std::shared_ptr<Frame> frame, int tileIdx, int step)
+        : ThreadPoolJob ("Heatmap tile"), owner (owner), frame (frame), tileIdx (tileIdx), step (step)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        int tileX = (tileIdx % frame->numTilesX) * Global::heatmapTileSize;
+        int tileY = (tileIdx / frame->numTilesX) * Global::heatmapTileSize;
+        int tileWidth = jmin (Global::heatmapTileSize, frame->width - tileX);
+        int tileHeight = jmin (Global::heatmapTileSize, frame->height - tileY);
+
+        std::vector<float>& dB = step == 1 ? frame->fineDB : frame->coarseDB;
+        float rowDB[Global::heatmapTileSize];
+        int numPoints = (tileWidth + step - 1) / step;
+
+        for (int y = tileY; y < tileY + tileHeight; y += step)
+        {
+            // stop as soon as the coefficients or the view have changed
+            if (shouldExit() || owner.generation.load() != frame->generation)
+                return jobHasFinished;
+
+            evaluateRow (frame->imagMax - y * frame->imagStep,
+                         frame->realMin + tileX * frame->realStep,
+                         frame->realStep * step, numPoints, rowDB);
+
+            // on the coarse grid every point fills a block of step x step pixels
+            for (int j = y; j < jmin (y + step, tileY + tileHeight); ++j)
+                for (int x = 0; x < tileWidth; ++x)
+                    dB[j * frame->width + tileX + x] = rowDB[x / step];
+        }
+
+        frame->tileState[tileIdx].fetch_or (step == 1 ? 2 : 1);
+        owner.sendChangeMessage();
+        return jobHasFinished;
+    }
+
+private:
+    // Evaluates the gain at numPoints points on a horizontal line in the z-plane. Multiplying numerator and
+    // denominator by z^5 turns both into polynomials in z that are evaluated with Horner's method for all
+    // points at once. The loops have no branches so the compiler can vectorise them.
+    void evaluateRow (double imag, double realStart, double realStep, int numPoints, float* dest)
+    {
+        double zReal[Global::heatmapTileSize];
+        double numReal[Global::heatmapTileSize];
+        double numImag[Global::heatmapTileSize];
+        double denReal[Global::heatmapTileSize];
+        double denImag[Global::heatmapTileSize];
+
+        for (int n = 0; n < numPoints; ++n)
+        {
+            zReal[n] = realStart + n * realStep;
+            numReal[n] = frame->b[0];
+            numImag[n] = 0.0;
+            denReal[n] = 1.0;
+            denImag[n] = 0.0;
+        }
+
+        for (int k = 1; k < Global::numCoeffs / 2; ++k)
+        {
+            double b = frame->b[k];
+            double a = frame->a[k];
+            for (int n = 0; n < numPoints; ++n)
+            {
+                double tempReal = numReal[n] * zReal[n] - numImag[n] * imag + b;
+                numImag[n] = numReal[n] * imag + numImag[n] * zReal[n];
+                numReal[n] = tempReal;
+
+                tempReal = denReal[n] * zReal[n] - denImag[n] * imag - a;
+                denImag[n] = denReal[n] * imag + denImag[n] * zReal[n];
+                denReal[n] = tempReal;
+            }
+        }
+
+        // a tiny offset keeps 0 / 0 at 0 dB instead of NaN
+        for (int n = 0; n < numPoints; ++n)
+        {
+            double numPower = numReal[n] * numReal[n] + numImag[n] * numImag[n] + 1e-300;
+            double denPower = denReal[n] * denReal[n] + denImag[n] * denImag[n] + 1e-300;
+            dest[n] = static_cast<float> (10.0 * log10 (numPower / denPower));
+        }
+    }
+
+    ZPlaneHeatmap& owner;
+    std::shared_ptr<Frame> frame;
+    int tileIdx;
+    int step;
+};
+
+//==============================================================================
+ZPlaneHeatmap::ZPlaneHeatmap()
+{
+    // blue for low gain to red for high gain
+    for (int i = 0; i < 256; ++i)
+        colourMap[i] = Colour::fromHSV (0.66f * (1.0f - i / 255.0f), 0.8f, 1.0f, 0.6f);
+}
+
+ZPlaneHeatmap::~ZPlaneHeatmap()
+{
+    ++generation;
+    threadPool.removeAllJobs (true, 1000);
+}
+
+void ZPlaneHeatmap::calculate (const std::vector<double>& coefficients,
+                               double realMin, double realMax, double imagMin, double imagMax,
+                               int width, int height)
+{
+    // the running tiles see the new generation and stop after their current row
+    stop();
+
+    if (width <= 0 || height <= 0)
+        return;
+
+    auto newFrame = std::make_shared<Frame>();
+    newFrame->generation = generation.load();
+
+    int halfNumCoeffs = Global::numCoeffs / 2;
+    for (int k = 0; k < halfNumCoeffs; ++k)
+    {
+        newFrame->b[k] = coefficients[k];
+        newFrame->a[k] = coefficients[k + halfNumCoeffs];
+    }
+
+    newFrame->width = width;
+    newFrame->height = height;
+    newFrame->realMin = realMin;
+    newFrame->realStep = (realMax - realMin) / width;
+    newFrame->imagMax = imagMax;
+    newFrame->imagStep = (imagMax - imagMin) / height;
+    newFrame->numTilesX = (width + Global::heatmapTileSize - 1) / Global::heatmapTileSize;
+    newFrame->numTilesY = (height + Global::heatmapTileSize - 1) / Global::heatmapTileSize;
+    newFrame->coarseDB.resize (width * height);
+    newFrame->fineDB.resize (width * height);
+
+    int numTiles = newFrame->numTilesX * newFrame->numTilesY;
+    newFrame->tileState.reset (new std::atomic<int>[numTiles]);
+    for (int i = 0; i < numTiles; ++i)
+        newFrame->tileState[i].store (0);
+
+    frame = newFrame;
+    compositedState.assign (numTiles, 0);
+
+    // keep showing the old image until the new tiles arrive, unless the size has changed
+    if (image.getWidth() != width || image.getHeight() != height)
+        image = Image (Image::ARGB, width, height, true);
+
+    // the pool runs the jobs in the order they are added, so the whole coarse pass comes first
+    for (int i = 0; i < numTiles; ++i)
+        threadPool.addJob (new TileJob (*this, frame, i, Global::heatmapCoarseStep), true);
+    for (int i = 0; i < numTiles; ++i)
+        threadPool.addJob (new TileJob (*this, frame, i, 1), true);
+}
+
+void ZPlaneHeatmap::stop()
+{
+    ++generation;
+    threadPool.removeAllJobs (true, 0);
+}
+
+void ZPlaneHeatmap::draw (Graphics& g, Rectangle<float> area)
+{
+    compositeFinishedTiles();
+    if (image.isValid())
+        g.drawImage (image, area);
+}
+
+void ZPlaneHeatmap::compositeFinishedTiles()
+{
+    if (frame == nullptr)
+        return;
+
+    Image::BitmapData bitmap (image, Image::BitmapData::writeOnly);
+    double dBRange = Global::heatmapMaxDB - Global::heatmapMinDB;
+
+    for (int i = 0; i < compositedState.size(); ++i)
+    {
+        int state = frame->tileState[i].load();
+
+        const std::vector<float>* dB = nullptr;
+        if ((state & 2) && compositedState[i] < 2)
+        {
+            dB = &frame->fineDB;
+            compositedState[i] = 2;
+        }
+        else if ((state & 1) && compositedState[i] < 1)
+        {
+            dB = &frame->coarseDB;
+            compositedState[i] = 1;
+        }
+
+        if (dB == nullptr)
+            continue;
+
+        int tileX = (i % frame->numTilesX) * Global::heatmapTileSize;
+        int tileY = (i / frame->numTilesX) * Global::heatmapTileSize;
+        for (int y = tileY; y < jmin (tileY + Global::heatmapTileSize, frame->height); ++y)
+        {
+            for (int x = tileX; x < jmin (tileX + Global::heatmapTileSize, frame->width); ++x)
+            {
+                double normalised = Global::limit (((*dB)[y * frame->width + x] - Global::heatmapMinDB) / dBRange, 0.0, 1.0);
+                bitmap.setPixelColour (x, y, colourMap[static_cast<int> (normalised * 255)]);
+            }
+        }
+    }
+}
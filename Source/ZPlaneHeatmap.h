@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    ZPlaneHeatmap.h
+    Created: 18 Oct 2026 8:25:36pm
+    Author:  Silvin Willemsen
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Global.h"
+#include <atomic>
+
+//==============================================================================
+/*
+    Computes |H(z)| in dB over a rectangular region of the z-plane. The image is
+    split into tiles that are calculated on a thread pool, first on a coarse grid
+    and then at full resolution. A change message is sent whenever a tile is done.
+*/
+class ZPlaneHeatmap : public ChangeBroadcaster
+{
+public:
+    ZPlaneHeatmap();
+    ~ZPlaneHeatmap() override;
+
+    // start calculating a new heatmap (cancels the tiles of the previous one)
+    void calculate (const std::vector<double>& coefficients,
+                    double realMin, double realMax, double imagMin, double imagMax,
+                    int width, int height);
+
+    // cancel all tiles that are not done yet
+    void stop();
+
+    // copy the finished tiles into the image and draw it (call from the message thread)
+    void draw (Graphics& g, Rectangle<float> area);
+
+private:
+    struct Frame;
+    class TileJob;
+
+    void compositeFinishedTiles();
+
+    ThreadPool threadPool { jmax (1, SystemStats::getNumCpus() - 1) };
+    std::atomic<uint32> generation { 0 };
+
+    std::shared_ptr<Frame> frame;
+    std::vector<int> compositedState; // per tile: 0 : nothing, 1 : coarse, 2 : full resolution
+    Image image;
+
+    Colour colourMap[256];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZPlaneHeatmap)
+};